@@ -0,0 +1,60 @@
+#ifndef BENCH_LEVEL_HPP
+#define BENCH_LEVEL_HPP
+
+// Fixtures shared by the benchmarks, so a fix to the test level reaches every bench at once.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "LevelFormat.hpp"
+
+// The benches' pseudo-random source: a plain LCG, identical on every platform.
+inline uint32_t nextRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// Ground segments with staggered steps and ledges -- roughly the hand-built levels repeated
+// out to `count` platforms -- over a floor spanning the whole level. The floor goes first and
+// counts towards `count`: one long platform must not slow down the queries of everything
+// after it. The spawn is above the highest ledge, so the player never starts inside a step.
+inline LevelData makeLevel(size_t count, bool longFloor = true) {
+    LevelData level;
+    level.hasSpawn = true;
+    level.spawn = { 0.0f, 4.0f };
+    level.platforms.reserve(count);
+    uint32_t seed = 12345u;
+    float x = -10.0f;
+    if (longFloor) {
+        const float width = 20.0f * (count / 8 + 1);
+        level.platforms.push_back({ {x + width / 2.0f, -2.5f}, {width, 0.2f} });
+    }
+    while (level.platforms.size() < count) {
+        level.platforms.push_back({ {x + 10.0f, -2.0f}, {20.0f, 0.2f} });
+        for (int i = 0; i < 7 && level.platforms.size() < count; ++i) {
+            float px = x + 1.5f + 2.5f * i;
+            // Either a low step to hop onto or an overhead ledge with room to run under.
+            float py = (nextRandom(seed) & 1) ? -1.5f : -0.6f + (nextRandom(seed) % 300) / 100.0f;
+            float w = 0.8f + (nextRandom(seed) % 200) / 100.0f;
+            level.platforms.push_back({ {px, py}, {w, 0.2f} });
+        }
+        x += 20.0f;
+    }
+    return level;
+}
+
+// Parses a --option list such as "1000,10000,100000", raising each entry to `minimum`.
+inline std::vector<size_t> parseSizes(const char* list, size_t minimum = 0) {
+    std::vector<size_t> sizes;
+    for (const char* p = list; *p;) {
+        sizes.push_back(std::max<size_t>(minimum, std::strtoul(p, nullptr, 10)));
+        p = std::strchr(p, ',');
+        if (!p) break;
+        ++p;
+    }
+    return sizes;
+}
+
+#endif // BENCH_LEVEL_HPP
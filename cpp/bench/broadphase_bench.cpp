@@ -0,0 +1,204 @@
+// Broadphase benchmark: runs the ground probe and Y/X resolution passes from Game::update
+// against generated levels, once with the original full platform scan and once through
+// PlatformGrid, checks that both produce bit-identical trajectories, and reports ns/frame.
+// The ground probe alone is then timed on the grid and through PlatformSweep::castDown at
+// every position of the trajectory, and the two must agree. A scripted landing that rounds to one ulp inside a platform is checked first.
+//
+// Build: g++ -O2 -std=c++17 -Icpp/src cpp/bench/broadphase_bench.cpp -o broadphase_bench
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "BenchLevel.hpp"
+#include "Collision.hpp"
+#include "PhysicsProfile.hpp"
+#include "PlatformSweep.hpp"
+
+namespace {
+
+// The per-frame loops as they were before the grid existed, plus the whole-ulp step that
+// resolveY has since gained.
+bool bruteProbe(const std::vector<Platform>& platforms, const Vec2& position, const Vec2& size) {
+    Vec2 groundCheckPos = {position.x, position.y - size.y / 2.0f - 0.05f};
+    Vec2 groundCheckSize = {size.x * 0.9f, 0.1f};
+    for (const auto& platform : platforms) {
+        if (checkCollision(groundCheckPos, groundCheckSize, platform.position, platform.size)) return true;
+    }
+    return false;
+}
+
+void bruteResolveY(const std::vector<Platform>& platforms, Vec2& position, Vec2& velocity, const Vec2& size) {
+    for (const auto& platform : platforms) {
+        if (checkCollision(position, size, platform.position, platform.size)) {
+            float deltaY = position.y - platform.position.y;
+            float penetrationY = (size.y / 2.0f + platform.size.y / 2.0f) - std::abs(deltaY);
+            if (deltaY > 0) {
+                position.y += penetrationY;
+                const float top = platform.position.y + platform.size.y / 2.0f;
+                while (position.y - size.y / 2.0f < top) position.y = std::nextafter(position.y, INFINITY);
+                if (velocity.y < 0) velocity.y = 0;
+            } else {
+                position.y -= penetrationY;
+                const float bottom = platform.position.y - platform.size.y / 2.0f;
+                while (position.y + size.y / 2.0f > bottom) position.y = std::nextafter(position.y, -INFINITY);
+                if (velocity.y > 0) velocity.y = 0;
+            }
+        }
+    }
+}
+
+void bruteResolveX(const std::vector<Platform>& platforms, Vec2& position, Vec2& velocity, const Vec2& size) {
+    for (const auto& platform : platforms) {
+        if (checkCollision(position, size, platform.position, platform.size)) {
+            float deltaX = position.x - platform.position.x;
+            float penetrationX = (size.x / 2.0f + platform.size.x / 2.0f) - std::abs(deltaX);
+            if (deltaX > 0) position.x += penetrationX;
+            else position.x -= penetrationX;
+            velocity.x = 0;
+        }
+    }
+}
+
+struct Body {
+    Vec2 position{ 0.0f, -1.5f };
+    Vec2 velocity{ 0.0f, 0.0f };
+    Vec2 size{ 0.5f, 0.8f };
+    bool grounded = false;
+};
+
+bool sameBody(const Body& a, const Body& b) {
+    return std::memcmp(&a.position, &b.position, sizeof(Vec2)) == 0 && std::memcmp(&a.velocity, &b.velocity, sizeof(Vec2)) == 0;
+}
+
+// A landing whose penetration rounds to one ulp short of the top face: without the step
+// clear, the body stays inside the platform and the next resolveX pushes it off sideways as
+// if it had hit a wall. Both resolves must leave it standing on the face, still running.
+bool ulpLandingHolds() {
+    const std::vector<Platform> platforms = { { {0.0f, -0.999f}, {4.0f, 0.2f} } };
+    PlatformGrid grid;
+    grid.build(platforms);
+    GridScratch scratch;
+    const float dt = 1.0f / 60.0f;
+    Body brute;
+    brute.position = { 0.0f, -0.4995f };
+    brute.velocity = { 2.0f, -1.0f };
+    Body fast = brute;
+    const Vec2 prev = { brute.position.x, brute.position.y - brute.velocity.y * dt };
+
+    bruteResolveY(platforms, brute.position, brute.velocity, brute.size);
+    brute.position.x += brute.velocity.x * dt;
+    bruteResolveX(platforms, brute.position, brute.velocity, brute.size);
+
+    resolveY(platforms, grid, scratch, fast.position, fast.velocity, fast.size, prev);
+    const Vec2 landed = fast.position;
+    fast.position.x += fast.velocity.x * dt;
+    resolveX(platforms, grid, scratch, fast.position, fast.velocity, fast.size, landed);
+
+    const float top = platforms[0].position.y + platforms[0].size.y / 2.0f;
+    return sameBody(brute, fast) && fast.position.y - fast.size.y / 2.0f >= top && fast.velocity.x == 2.0f;
+}
+
+// probeGround's test through the sweep: the probe box dropped from its top to its bottom.
+bool sweepProbe(const PlatformSweep& sweep, const Vec2& position, const Vec2& size) {
+    const Aabb probe = groundProbeBox(position, size, StandardPhysics::groundCheckDistance);
+    return sweep.castDown(probe.min.x, probe.max.x, probe.max.y, probe.min.y).hit;
+}
+
+template <typename Step>
+double run(Body& body, int frames, Step step) {
+    const float dt = 1.0f / 60.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        // Jump on a fixed cadence, or straight away when a wall stopped us last frame.
+        bool blocked = f > 0 && body.velocity.x == 0.0f;
+        body.velocity.x = 2.0f;
+        if (body.grounded && (blocked || f % 45 == 0)) body.velocity.y = 6.0f;
+        step(dt);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / frames;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const float gravity = -9.8f * 2.5f;
+    const size_t sizes[] = { 100, 1000, 10000, 100000 };
+
+    if (!ulpLandingHolds()) {
+        std::fprintf(stderr, "one-ulp landing: the body did not come to rest on the platform\n");
+        return 1;
+    }
+    std::printf("%10s %16s %16s %16s %16s\n", "platforms", "scan ns/frame", "grid ns/frame", "grid probe ns", "sweep probe ns");
+    for (size_t count : sizes) {
+        std::vector<Platform> platforms = makeLevel(count).platforms;
+        PlatformGrid grid;
+        grid.build(platforms);
+        PlatformSweep sweep;
+        sweep.build(platforms);
+        GridScratch scratch;
+
+        Body brute, fast;
+        std::vector<Body> bruteTrace, fastTrace;
+        bruteTrace.reserve(frames);
+        fastTrace.reserve(frames);
+
+        double bruteNs = run(brute, frames, [&](float dt) {
+            brute.grounded = bruteProbe(platforms, brute.position, brute.size);
+            if (!brute.grounded) brute.velocity.y += gravity * dt;
+            else brute.velocity.y = std::max(0.0f, brute.velocity.y);
+            brute.position.y += brute.velocity.y * dt;
+            bruteResolveY(platforms, brute.position, brute.velocity, brute.size);
+            brute.position.x += brute.velocity.x * dt;
+            bruteResolveX(platforms, brute.position, brute.velocity, brute.size);
+            bruteTrace.push_back(brute);
+        });
+        double gridNs = run(fast, frames, [&](float dt) {
+            fast.grounded = probeGround(grid, scratch, fast.position, fast.size, StandardPhysics::groundCheckDistance);
+            if (!fast.grounded) fast.velocity.y += gravity * dt;
+            else fast.velocity.y = std::max(0.0f, fast.velocity.y);
+            Vec2 prev = fast.position;
+            fast.position.y += fast.velocity.y * dt;
+            resolveY(platforms, grid, scratch, fast.position, fast.velocity, fast.size, prev);
+            prev = fast.position;
+            fast.position.x += fast.velocity.x * dt;
+            resolveX(platforms, grid, scratch, fast.position, fast.velocity, fast.size, prev);
+            fastTrace.push_back(fast);
+        });
+
+        for (int f = 0; f < frames; ++f) {
+            const Body& a = bruteTrace[f];
+            const Body& b = fastTrace[f];
+            if (!sameBody(a, b) || a.grounded != b.grounded) {
+                std::fprintf(stderr, "mismatch at %zu platforms, frame %d: scan (%.9g, %.9g) grid (%.9g, %.9g)\n",
+                             count, f, a.position.x, a.position.y, b.position.x, b.position.y);
+                return 1;
+            }
+        }
+        // The probe alone, on both structures, over every position the body passed through.
+        uint32_t gridHits = 0, sweepHits = 0;
+        auto probeStart = std::chrono::steady_clock::now();
+        for (const Body& b : fastTrace) gridHits += probeGround(grid, scratch, b.position, b.size, StandardPhysics::groundCheckDistance);
+        auto probeMid = std::chrono::steady_clock::now();
+        for (const Body& b : fastTrace) sweepHits += sweepProbe(sweep, b.position, b.size);
+        auto probeEnd = std::chrono::steady_clock::now();
+        for (const Body& b : fastTrace) {
+            if (probeGround(grid, scratch, b.position, b.size, StandardPhysics::groundCheckDistance) !=
+                sweepProbe(sweep, b.position, b.size)) {
+                std::fprintf(stderr, "ground probe differs between grid and sweep at %zu platforms (%.9g, %.9g)\n",
+                             count, b.position.x, b.position.y);
+                return 1;
+            }
+        }
+        const double gridProbeNs = std::chrono::duration<double, std::nano>(probeMid - probeStart).count() / frames;
+        const double sweepProbeNs = std::chrono::duration<double, std::nano>(probeEnd - probeMid).count() / frames;
+        if (gridHits != sweepHits) return 1; // keeps both timed loops from being dropped
+        std::printf("%10zu %16.0f %16.0f %16.1f %16.1f\n", count, bruteNs, gridNs, gridProbeNs, sweepProbeNs);
+    }
+    return 0;
+}
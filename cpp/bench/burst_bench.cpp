@@ -0,0 +1,211 @@
+// Burst emitter benchmark: the same effect stream -- bursts of particles flying out of
+// scattered points -- run through the per-particle ParticleSystem pool (every particle's
+// velocity and spin worked out at emission, then integrated and compacted each frame) and
+// through BurstSystem (one descriptor per burst, particles evaluated only when drawn), at
+// steady states of about 1k, 10k and 100k live particles. Reports live bytes, emit+update
+// and render ns/frame for both. Before printing a row it checks that the two agree: same live
+// particles in the same order, the pool's integrated state within rounding of the closed-form
+// burst state, and addBursts output identical to expanding every burst particle one by one
+// (so whole-burst culling never drops a visible particle). It also checks that a full
+// BurstSystem refuses new bursts and oversized snapshots, and that the burst step never
+// allocates. The bench fails if any check does.
+//
+// Usage: burst_bench [--live N,N,...] [--burst-size N] [--frames F]
+// Build: cmake -S cpp -B build && cmake --build build --target burst_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "AllocationHook.hpp"
+#include "BenchLevel.hpp"
+#include "ParticleBursts.hpp"
+#include "RenderBuffer.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const float Dt = 1.0f / 60.0f;
+const Aabb View = { { 20.0f, -2.0f }, { 60.0f, 12.0f } };
+
+float unit(uint32_t& state) { return (nextRandom(state) % 10000) / 10000.0f; }
+
+// Jump-like bursts over x in [0, 100). Lifetimes are a whole number of frames plus a half, so
+// the pool's float countdown and the bursts' double clock never disagree on which frame a
+// particle dies; they average 0.5 s, and the emission rate holds about `live` alive.
+std::vector<std::vector<ParticleBurst>> makeStream(size_t live, uint32_t burstSize, int frames) {
+    const size_t perFrame = std::max<size_t>(1, std::lround(live * Dt / 0.5f / burstSize));
+    uint32_t seed = 42u;
+    std::vector<std::vector<ParticleBurst>> stream(frames);
+    for (auto& batch : stream) {
+        batch.reserve(perFrame);
+        for (size_t i = 0; i < perFrame; ++i) {
+            const float lifetime = (18.0f + (nextRandom(seed) % 25) + 0.5f) * Dt;
+            batch.push_back({ { unit(seed) * 100.0f, unit(seed) * 10.0f }, { unit(seed) * 2.0f - 1.0f, 0.0f },
+                              { 0.5f, 0.5f }, 0.0f, 3.14159f, 1.0f, 2.0f, -5.0f, 10.0f, lifetime, 0.1f,
+                              nextRandom(seed), burstSize, 0.0 });
+        }
+    }
+    return stream;
+}
+
+// The per-particle model: what Game did before bursts, one pool entry per particle.
+void emitParticles(ParticleSystem& pool, const std::vector<ParticleBurst>& batch) {
+    for (const ParticleBurst& b : batch) {
+        for (uint32_t k = 0; k < b.count; ++k) {
+            pool.emit(b.origin, BurstSystem::velocityOf(b, k), b.lifetime, b.size, BurstSystem::spinOf(b, k));
+        }
+    }
+}
+
+void emitBursts(BurstSystem& bursts, const std::vector<ParticleBurst>& batch) {
+    for (const ParticleBurst& b : batch) bursts.emit(b);
+}
+
+bool near(float a, float b) { return std::abs(a - b) <= 1e-3f * (1.0f + std::abs(b)); }
+
+// Returns the name of the first check that failed, or nullptr.
+const char* check(const ParticleSystem& pool, const BurstSystem& bursts, RenderBuffer& buffer) {
+    if (pool.refusedCount() != 0) return "pool refused particles";
+    if (bursts.refusedCount() != 0) return "bursts refused";
+    if (pool.size() != bursts.particleCount()) return "live counts differ";
+    const ParticleArrays& a = pool.arrays();
+    size_t i = 0;
+    for (const ParticleBurst& b : bursts.data()) {
+        const float age = bursts.ageOf(b);
+        for (uint32_t k = 0; k < b.count; ++k, ++i) {
+            const BurstParticle p = BurstSystem::particleAt(b, k, age);
+            if (!near(a.positionX[i], p.position.x) || !near(a.positionY[i], p.position.y) ||
+                !near(a.rotation[i], p.rotation) || !near(a.life[i] / a.maxLife[i], p.alpha)) {
+                return "integrated particle differs from its closed form";
+            }
+        }
+    }
+
+    const ParticleSystem none(0);
+    buffer.begin();
+    buffer.addParticles(none, View);
+    buffer.addBursts(bursts, View);
+    std::vector<SpriteInstance> expected;
+    for (const ParticleBurst& b : bursts.data()) {
+        const float reach = b.size * 0.7072f;
+        for (uint32_t k = 0; k < b.count; ++k) {
+            const BurstParticle p = BurstSystem::particleAt(b, k, bursts.ageOf(b));
+            if (!RenderBuffer::overlaps({ { p.position.x - reach, p.position.y - reach }, { p.position.x + reach, p.position.y + reach } }, View)) continue;
+            expected.push_back({ p.position, { b.size, b.size }, p.rotation, p.alpha, { 0.0f, 0.0f } });
+        }
+    }
+    if (buffer.batchCount(RenderBatch::Particles) != expected.size() || buffer.data().size() != expected.size() ||
+        (!expected.empty() && std::memcmp(buffer.data().data(), expected.data(), expected.size() * sizeof(SpriteInstance)) != 0)) {
+        return "addBursts differs from the particle-by-particle expansion";
+    }
+    return nullptr;
+}
+
+// A full system refuses the next burst and keeps the live ones, without allocating, and
+// refuses to restore more bursts than it holds. Returns the first failed check, or nullptr.
+const char* checkOverflow() {
+    BurstSystem bursts(4);
+    const ParticleBurst burst = { { 0.0f, 0.0f }, { 0.0f, 0.0f }, { 1.0f, 1.0f }, 0.0f, 3.14159f, 1.0f, 2.0f,
+                                  0.0f, 0.0f, 1.0f, 0.1f, 7u, 8u, 0.0 };
+    const uint64_t before = heapAllocationCount();
+    int accepted = 0;
+    for (int i = 0; i < 5; ++i) accepted += bursts.emit(burst);
+    if (heapAllocationCount() != before) return "emitting allocated";
+    if (accepted != 4 || bursts.size() != 4 || bursts.refusedCount() != 1 || bursts.particleCount() != 32) {
+        return "a full system did not refuse the extra burst";
+    }
+    const std::vector<ParticleBurst> five(5, burst);
+    if (bursts.restore(0.0, reinterpret_cast<const uint8_t*>(five.data()), five.size()) || bursts.size() != 4) {
+        return "restored more bursts than the capacity";
+    }
+    return nullptr;
+}
+
+double since(Clock::time_point start, Clock::time_point end) { return std::chrono::duration<double, std::nano>(end - start).count(); }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<size_t> targets = { 1000, 10000, 100000 };
+    uint32_t burstSize = 32;
+    int frames = 300;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--live") == 0) targets = parseSizes(argv[i + 1], 1);
+        else if (std::strcmp(argv[i], "--burst-size") == 0) burstSize = std::min<uint32_t>(BurstSystem::MaxBurstSize, std::max(1, std::atoi(argv[i + 1])));
+        else if (std::strcmp(argv[i], "--frames") == 0) frames = std::max(1, std::atoi(argv[i + 1]));
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    if (const char* failure = checkOverflow()) {
+        std::fprintf(stderr, "burst capacity: %s\n", failure);
+        return 1;
+    }
+    std::printf("%u particles per burst, %d frames after warm-up; bytes live, ns/frame\n", burstSize, frames);
+    std::printf("%8s %7s %10s %10s %11s %11s %11s %11s %9s\n", "live", "bursts", "pool B", "burst B",
+                "pool step", "burst step", "pool draw", "burst draw", "drawn");
+    for (size_t target : targets) {
+        // Warm up past the longest lifetime so both are at steady state, then time.
+        const int warmup = 45;
+        const auto stream = makeStream(target, burstSize, warmup + frames);
+
+        // No particle outlives the warm-up, so this many can never all be alive at once.
+        ParticleSystem pool(stream[0].size() * burstSize * warmup);
+        BurstSystem bursts(stream[0].size() * warmup);
+        RenderBuffer poolBuffer, burstBuffer;
+        const ParticleSystem none(0);
+        double poolStep = 0.0, burstStep = 0.0, poolDraw = 0.0, burstDraw = 0.0;
+        uint64_t burstAllocations = 0;
+        for (int f = 0; f < warmup + frames; ++f) {
+            auto t0 = Clock::now();
+            pool.update(Dt);
+            emitParticles(pool, stream[f]);
+            auto t1 = Clock::now();
+            const uint64_t allocations = heapAllocationCount();
+            bursts.update(Dt);
+            emitBursts(bursts, stream[f]);
+            burstAllocations += heapAllocationCount() - allocations;
+            auto t2 = Clock::now();
+            poolBuffer.begin(pool.size());
+            poolBuffer.addParticles(pool, View);
+            auto t3 = Clock::now();
+            burstBuffer.begin(bursts.particleCount());
+            burstBuffer.addParticles(none, View);
+            burstBuffer.addBursts(bursts, View);
+            auto t4 = Clock::now();
+            if (f >= warmup) {
+                poolStep += since(t0, t1);
+                burstStep += since(t1, t2);
+                poolDraw += since(t2, t3);
+                burstDraw += since(t3, t4);
+            }
+        }
+
+        RenderBuffer checkBuffer;
+        if (burstAllocations != 0) {
+            std::fprintf(stderr, "%zu live: the burst step allocated %llu times\n", target,
+                         static_cast<unsigned long long>(burstAllocations));
+            return 1;
+        }
+        if (const char* failure = check(pool, bursts, checkBuffer)) {
+            std::fprintf(stderr, "%zu live: %s\n", target, failure);
+            return 1;
+        }
+        // The pool holds 9 floats per live particle (and reserves them up to its capacity);
+        // a burst holds one descriptor whatever its count.
+        const size_t poolBytes = pool.size() * 9 * sizeof(float);
+        const size_t burstBytes = bursts.size() * sizeof(ParticleBurst);
+        std::printf("%8zu %7zu %10zu %10zu %11.0f %11.0f %11.0f %11.0f %9u\n", pool.size(), bursts.size(), poolBytes,
+                    burstBytes, poolStep / frames, burstStep / frames, poolDraw / frames, burstDraw / frames,
+                    burstBuffer.batchCount(RenderBatch::Particles));
+    }
+    return 0;
+}
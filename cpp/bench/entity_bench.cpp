@@ -0,0 +1,144 @@
+// Entity benchmark: the whole game with 0, 1k and 10k patrolling enemies dropped onto a
+// game_bench-style level, reporting ns/frame and ns per moving body. Every run also has
+// moving platforms running back and forth high above the level, each with an enemy dropped
+// onto it. Neither ever touches the player, so the player's final position and velocity must
+// be bit-identical with and without the enemies; the bench fails if they differ. It first
+// checks that a player standing on a moving platform rides it, sideways and up, with no
+// NaN from the odd zero-length update.
+//
+// Usage: entity_bench [--bodies N,N,...] [--movers M] [--platforms N] [--frames F]
+// Build: cmake -S cpp -B build && cmake --build build --target entity_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "BenchLevel.hpp"
+#include "Game.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double nsPerFrame;
+    Vec2 playerPosition;
+    Vec2 playerVelocity;
+    uint32_t airborne; // enemies not standing on anything at the end
+};
+
+Result run(const std::vector<uint8_t>& level, float levelWidth, size_t bodies, size_t movers, int frames) {
+    Game game;
+    game.loadLevelBinary(level.data(), level.size());
+    game.setSeed(1);
+    for (size_t i = 0; i < movers; ++i) {
+        const float x = -8.0f + (levelWidth - 6.0f) * i / std::max<size_t>(movers, 1);
+        game.spawnMovingPlatform({ x, 12.0f }, { x + 3.0f, 12.0f + (i % 3) }, { 2.0f, 0.2f }, 1.0f + (i % 4) * 0.5f);
+        game.spawnEntity(EntityKind::Enemy, { x, 13.0f }, { 0.5f, 0.5f });
+    }
+    uint32_t seed = 777u;
+    for (size_t i = 0; i < bodies; ++i) {
+        // Spread across the level, dropped from above the highest ledge.
+        const float x = -9.0f + (nextRandom(seed) % 10000) / 10000.0f * (levelWidth - 2.0f);
+        game.spawnEntity(EntityKind::Enemy, { x, 5.0f + (nextRandom(seed) % 400) / 100.0f }, { 0.5f, 0.5f });
+    }
+
+    const InputState right{ false, true, false };
+    const InputState rightJump{ false, true, true };
+    auto start = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        game.handleInput(f % 44 < 40 ? right : rightJump);
+        game.update(1.0f / 60.0f);
+        game.drainEvents();
+    }
+    const double totalNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    const EntityStore& entities = game.getEntities();
+    uint32_t airborne = 0;
+    for (uint32_t i = 1; i < entities.size(); ++i) airborne += entities.dynamic[i] && !entities.grounded[i] ? 1 : 0;
+    return { totalNs / frames, entities.position(PlayerEntity), entities.velocity(PlayerEntity), airborne };
+}
+
+// Drops the player onto a moving platform (and nothing else) and lets it ride for a few
+// seconds. It must stay grounded, keep its offset along the platform, and stand on its top.
+bool ridesMover(const Vec2& end) {
+    Game game;
+    LevelData empty;
+    empty.hasSpawn = true;
+    empty.spawn = { 0.5f, 1.0f };
+    std::vector<uint8_t> level;
+    writeLevelBinary(empty, level);
+    game.loadLevelBinary(level.data(), level.size());
+    const uint32_t mover = game.spawnMovingPlatform({ 0.0f, 0.0f }, end, { 3.0f, 0.2f }, 1.0f);
+    const InputState none{ false, false, false };
+    for (int f = 0; f < 60; ++f) { // land
+        game.handleInput(none);
+        game.update(1.0f / 60.0f);
+    }
+    const EntityStore& e = game.getEntities();
+    const float offset = e.positionX[PlayerEntity] - e.positionX[mover];
+    for (int f = 0; f < 300; ++f) {
+        game.handleInput(none);
+        game.update(f % 50 == 0 ? 0.0f : 1.0f / 60.0f); // a zero step now and then must not move anything
+        if (!std::isfinite(e.velocityX[mover]) || !std::isfinite(e.velocityY[mover]) ||
+            !std::isfinite(e.velocityX[PlayerEntity]) || !std::isfinite(e.velocityY[PlayerEntity])) {
+            return false;
+        }
+        const float top = e.positionY[mover] + e.sizeY[mover] / 2.0f;
+        const float feet = e.positionY[PlayerEntity] - e.sizeY[PlayerEntity] / 2.0f;
+        if (!e.grounded[PlayerEntity] || std::abs(e.positionX[PlayerEntity] - e.positionX[mover] - offset) > 1e-4f ||
+            feet < top || feet > top + 0.1f) { // grounded = within the probe's reach
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<size_t> bodyCounts = { 0, 1000, 10000 };
+    size_t movers = 100;
+    size_t platforms = 10000;
+    int frames = 2000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--bodies") == 0) bodyCounts = parseSizes(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--movers") == 0) movers = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--platforms") == 0) platforms = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--frames") == 0) frames = std::max(1, std::atoi(argv[i + 1]));
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    std::vector<uint8_t> level;
+    const LevelData data = makeLevel(platforms);
+    const float levelWidth = static_cast<float>((platforms + 7) / 8) * 20.0f;
+    writeLevelBinary(data, level);
+
+    if (!ridesMover({ 4.0f, 0.0f }) || !ridesMover({ 0.0f, 3.0f })) {
+        std::fprintf(stderr, "the player did not ride a moving platform\n");
+        return 1;
+    }
+
+    const Result baseline = run(level, levelWidth, 0, movers, frames);
+    std::printf("%zu moving platforms\n", movers);
+    std::printf("%10s %12s %12s %10s %22s\n", "bodies", "ns/frame", "ns/body", "airborne", "player position");
+    for (size_t bodies : bodyCounts) {
+        const Result r = bodies == 0 ? baseline : run(level, levelWidth, bodies, movers, frames);
+        if (std::memcmp(&r.playerPosition, &baseline.playerPosition, sizeof(Vec2)) != 0 ||
+            std::memcmp(&r.playerVelocity, &baseline.playerVelocity, sizeof(Vec2)) != 0) {
+            std::fprintf(stderr, "player trajectory changed with %zu bodies\n", bodies);
+            return 1;
+        }
+        const double perBody = bodies ? (r.nsPerFrame - baseline.nsPerFrame) / bodies : 0.0;
+        std::printf("%10zu %12.0f %12.2f %10u %10.4f,%10.4f\n", bodies, r.nsPerFrame, perBody, r.airborne,
+                    r.playerPosition.x, r.playerPosition.y);
+    }
+    return 0;
+}
@@ -0,0 +1,299 @@
+// Whole-game benchmark: replays scripted InputState sequences through Game::handleInput and
+// Game::update on generated levels and reports ns/frame, heap allocations per frame and
+// particle counts. Every run is first recorded and replayed on a fresh Game, and the bench
+// fails if the replay's state checksums diverge. It also fails if, after a short warm-up, a
+// frame of update() plus the getters a host calls every frame allocates at all. The final
+// player position doubles as a regression check when comparing builds.
+//
+// Usage: game_bench [--platforms N,N,...] [--frames F] [--script idle|run|zigzag]
+//                   [--record out.replay]   save the first run's recording
+//                   [--replay in.replay]    time and verify a recording on the first --platforms level
+//                   [--profile out.json]    save the first run's frame stats (Profiler JSON)
+//                   [--trace out.json]      save the first run's last frames as a Chrome trace
+// Build: cmake -S cpp -B build && cmake --build build --target game_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "AllocationHook.hpp"
+#include "BenchLevel.hpp"
+#include "Game.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// A script is a list of (frames, input) segments played in a loop.
+struct Segment {
+    int frames;
+    InputState input;
+};
+
+struct Script {
+    const char* name;
+    std::vector<Segment> segments;
+};
+
+std::vector<Script> makeScripts() {
+    const InputState none{ false, false, false };
+    const InputState right{ false, true, false };
+    const InputState rightJump{ false, true, true };
+    const InputState left{ true, false, false };
+    const InputState leftJump{ true, false, true };
+    return {
+        { "idle", { { 60, none } } },
+        { "run", { { 40, right }, { 4, rightJump } } },
+        { "zigzag", { { 150, right }, { 3, rightJump }, { 90, left }, { 3, leftJump } } },
+    };
+}
+
+struct Result {
+    double nsPerFrame;
+    double p99Ns;
+    double allocationsPerFrame;
+    double averageParticles;
+    uint32_t maxParticles;
+    Vec2 finalPosition;
+};
+
+// Plays `frames` frames of the looping script, calling after(game) once per frame.
+template <typename After>
+void playScript(Game& game, const Script& script, int frames, After after) {
+    size_t segment = 0;
+    int segmentFrame = 0;
+    for (int f = 0; f < frames; ++f) {
+        const Segment& current = script.segments[segment];
+        game.handleInput(current.input);
+        game.update(1.0f / 60.0f);
+        after(game);
+        if (++segmentFrame == current.frames) {
+            segmentFrame = 0;
+            segment = (segment + 1) % script.segments.size();
+        }
+    }
+}
+
+// The published stats must describe the frame that just ran: one tick, phases that fit inside
+// the frame, and a histogram holding every frame of the window.
+bool frameStatsConsistent(const Game& game, int framesRun) {
+    if (!PLATFORMER_PROFILE) return true;
+    const FrameStats& stats = game.getFrameStats();
+    float phases = 0.0f;
+    for (float micros : stats.phaseMicros) phases += micros;
+    uint32_t histogram = 0;
+    for (uint32_t n : stats.histogram) histogram += n;
+    return stats.frame == static_cast<uint32_t>(framesRun) && stats.counters[static_cast<uint32_t>(ProfileCounter::Steps)] == 1 &&
+           phases <= stats.frameMicros * 1.001f + 0.01f && stats.maxMicros >= stats.averageMicros &&
+           histogram == std::min<uint32_t>(static_cast<uint32_t>(framesRun), FrameHistogramWindow) &&
+           stats.counters[static_cast<uint32_t>(ProfileCounter::ParticlesAlive)] == game.getParticleCount() + game.getBurstParticleCount();
+}
+
+Result run(const std::vector<uint8_t>& level, const Script& script, int frames, bool& statsOk,
+           std::string* profileJson = nullptr, std::string* trace = nullptr) {
+    Game game;
+    game.loadLevelBinary(level.data(), level.size());
+    game.setSeed(1);
+    std::vector<double> frameNs(static_cast<size_t>(frames));
+    uint64_t particleSum = 0;
+    uint32_t maxParticles = 0;
+    size_t frame = 0;
+
+    const uint64_t allocationsBefore = heapAllocationCount();
+    auto start = Clock::now();
+    auto frameStart = start;
+    playScript(game, script, frames, [&](const Game& g) {
+        auto now = Clock::now();
+        frameNs[frame++] = std::chrono::duration<double, std::nano>(now - frameStart).count();
+        const uint32_t particles = g.getParticleCount() + g.getBurstParticleCount();
+        particleSum += particles;
+        maxParticles = std::max(maxParticles, particles);
+        frameStart = Clock::now();
+    });
+    const double totalNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    const uint64_t allocations = heapAllocationCount() - allocationsBefore;
+    statsOk = frameStatsConsistent(game, frames);
+    if (profileJson) game.getProfiler().writeJson(*profileJson);
+    if (trace) game.getProfiler().writeChromeTrace(*trace);
+
+    std::sort(frameNs.begin(), frameNs.end());
+    return { totalNs / frames, frameNs[static_cast<size_t>(frames * 0.99)],
+             static_cast<double>(allocations) / frames, static_cast<double>(particleSum) / frames,
+             maxParticles, game.getPlayerPosition() };
+}
+
+// What a host reads back every frame: positions, animation, events and the render views.
+void readFrame(Game& game) {
+    game.drainEvents();
+    game.getPlayerAnimationState();
+    game.getPlayerPosition();
+    game.getPreviousPlayerPosition();
+    game.getPreviousCameraPosition();
+    game.getInterpolationAlpha();
+    game.getParticleView();
+    game.getEntityView();
+    game.getPlatformView();
+    game.getFrameStatsView();
+    if (game.hasGeometryChanged(game.getPlatformRevision())) game.getStaticSpriteView();
+    game.buildRenderBuffer(11.0f, 6.5f);
+    const Vec2 camera = game.getCameraPosition();
+    const uint32_t runs = game.findStaticSpriteRanges(camera.x - 5.5f, camera.x + 5.5f);
+    for (uint32_t r = 0; r < runs; ++r) game.getStaticSpriteRange(r);
+}
+
+// Heap allocations made by update() and readFrame() once the first WarmupFrames frames have
+// grown every reusable buffer. Steady-state frames must not allocate.
+constexpr int WarmupFrames = 60;
+
+uint64_t steadyStateAllocations(const std::vector<uint8_t>& level, const Script& script, int frames) {
+    Game game;
+    game.loadLevelBinary(level.data(), level.size());
+    game.setSeed(1);
+    int frame = 0;
+    uint64_t before = heapAllocationCount();
+    playScript(game, script, frames, [&](Game& g) {
+        readFrame(g);
+        if (++frame == WarmupFrames) before = heapAllocationCount();
+    });
+    return frames > WarmupFrames ? heapAllocationCount() - before : 0;
+}
+
+// Records the script, then replays the recording on a freshly loaded Game. Returns the first
+// frame whose state checksum diverged, or -1.
+int32_t checkReplay(const std::vector<uint8_t>& level, const Script& script, int frames, std::vector<uint8_t>& recording) {
+    Game recorded;
+    recorded.loadLevelBinary(level.data(), level.size());
+    recorded.startRecording(1, 60);
+    playScript(recorded, script, frames, [](const Game&) {});
+    recorded.stopRecording();
+    recording = recorded.getRecording();
+
+    Game replayed;
+    replayed.loadLevelBinary(level.data(), level.size());
+    replayed.startReplay(recording.data(), recording.size());
+    const int32_t divergence = replayed.runReplay();
+    if (divergence < 0 && replayed.getStateChecksum() != recorded.getStateChecksum()) return frames;
+    return divergence;
+}
+
+bool readFile(const char* path, std::vector<uint8_t>& out) {
+    FILE* file = std::fopen(path, "rb");
+    if (!file) return false;
+    std::fseek(file, 0, SEEK_END);
+    out.resize(static_cast<size_t>(std::ftell(file)));
+    std::fseek(file, 0, SEEK_SET);
+    const bool ok = std::fread(out.data(), 1, out.size(), file) == out.size();
+    std::fclose(file);
+    return ok;
+}
+
+template <typename Bytes>
+bool writeFile(const char* path, const Bytes& data) {
+    FILE* file = std::fopen(path, "wb");
+    if (!file) return false;
+    const bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    std::fclose(file);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<size_t> sizes = { 1000, 10000, 100000 };
+    int frames = 20000;
+    std::string only;
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    const char* profilePath = nullptr;
+    const char* tracePath = nullptr;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--platforms") == 0) sizes = parseSizes(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--frames") == 0) frames = std::max(1, std::atoi(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--script") == 0) only = argv[i + 1];
+        else if (std::strcmp(argv[i], "--record") == 0) recordPath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--replay") == 0) replayPath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--profile") == 0) profilePath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--trace") == 0) tracePath = argv[i + 1];
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    if (replayPath) {
+        // Benchmark a recorded session against the first --platforms level.
+        std::vector<uint8_t> recording, level;
+        if (!readFile(replayPath, recording)) {
+            std::fprintf(stderr, "could not read %s\n", replayPath);
+            return 2;
+        }
+        writeLevelBinary(makeLevel(sizes.front()), level);
+        Game game;
+        game.loadLevelBinary(level.data(), level.size());
+        if (!game.startReplay(recording.data(), recording.size())) {
+            std::fprintf(stderr, "%s is not a replay\n", replayPath);
+            return 2;
+        }
+        auto start = Clock::now();
+        const int32_t divergence = game.runReplay();
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (divergence >= 0) {
+            std::fprintf(stderr, "replay diverged at frame %d\n", divergence);
+            return 1;
+        }
+        std::printf("replayed %s in %.2f ms, checksums match\n", replayPath, ms);
+        return 0;
+    }
+
+    std::printf("%-8s %10s %12s %10s %12s %10s %8s %22s\n", "script", "platforms", "ns/frame", "p99 ns",
+                "allocs/frame", "particles", "max", "final position");
+    for (const Script& script : makeScripts()) {
+        if (!only.empty() && only != script.name) continue;
+        for (size_t count : sizes) {
+            std::vector<uint8_t> level, recording;
+            writeLevelBinary(makeLevel(count), level);
+            const int32_t divergence = checkReplay(level, script, frames, recording);
+            if (divergence >= 0) {
+                std::fprintf(stderr, "%s at %zu platforms: replay diverged at frame %d\n", script.name, count, divergence);
+                return 1;
+            }
+            const uint64_t steadyAllocations = steadyStateAllocations(level, script, frames);
+            if (steadyAllocations != 0) {
+                std::fprintf(stderr, "%s at %zu platforms: %llu heap allocations after warm-up (expected none)\n", script.name,
+                             count, static_cast<unsigned long long>(steadyAllocations));
+                return 1;
+            }
+            if (recordPath) {
+                if (!writeFile(recordPath, recording)) {
+                    std::fprintf(stderr, "could not write %s\n", recordPath);
+                    return 2;
+                }
+                std::printf("recorded %s at %zu platforms to %s (%zu bytes)\n", script.name, count, recordPath, recording.size());
+                recordPath = nullptr; // only the first run
+            }
+            std::string profileJson, trace;
+            bool statsOk = false;
+            const Result r = run(level, script, frames, statsOk, profilePath ? &profileJson : nullptr,
+                                 tracePath ? &trace : nullptr);
+            if (!statsOk) {
+                std::fprintf(stderr, "%s at %zu platforms: frame stats do not match the last frame\n", script.name, count);
+                return 1;
+            }
+            for (const char* path : { profilePath, tracePath }) {
+                if (path && !writeFile(path, path == profilePath ? profileJson : trace)) {
+                    std::fprintf(stderr, "could not write %s\n", path);
+                    return 2;
+                }
+            }
+            profilePath = tracePath = nullptr; // only the first run
+            std::printf("%-8s %10zu %12.0f %10.0f %12.3f %10.1f %8u %10.4f,%10.4f\n", script.name, count,
+                        r.nsPerFrame, r.p99Ns, r.allocationsPerFrame, r.averageParticles, r.maxParticles,
+                        r.finalPosition.x, r.finalPosition.y);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Binary level load benchmark: writes synthetic levels in the LevelFormat.hpp layout, then
+// times loading them natively through an mmap and through a plain read into a buffer,
+// including the broadphase build Game does on load. Checks the decoded records match the
+// generated level bit for bit. The JSON-vs-binary comparison needs the WASM build; see
+// scripts/bench-level-load.mjs.
+//
+// Build: g++ -O2 -std=c++17 -Icpp/src cpp/bench/level_load_bench.cpp -o level_load_bench
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "BenchLevel.hpp"
+#include "LevelFile.hpp"
+#include "LevelFormat.hpp"
+#include "PlatformGrid.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+float unit(uint32_t& state) { return (nextRandom(state) % 100000) / 100000.0f; }
+
+// Platforms scattered along x, with a spawn, bounds and a goal, so every part of the format
+// is exercised.
+LevelData makeScatteredLevel(size_t count) {
+    LevelData level;
+    uint32_t seed = 12345u;
+    level.hasSpawn = true;
+    level.spawn = { 0.0f, 5.0f };
+    level.hasBounds = true;
+    level.boundsMin = { -10.0f, -10.0f };
+    level.boundsMax = { count * 1.5f + 10.0f, 10.0f };
+    for (size_t i = 0; i < count; ++i) {
+        level.platforms.push_back({ { i * 1.5f + unit(seed), unit(seed) * 8.0f - 4.0f }, { 0.5f + unit(seed) * 2.0f, 0.2f } });
+    }
+    level.goals.push_back({ { count * 1.5f, 5.0f }, { 1.0f, 1.0f } });
+    return level;
+}
+
+bool sameRecords(const std::vector<Platform>& a, const std::vector<Platform>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(Platform)) == 0;
+}
+
+bool readWhole(const char* path, std::vector<uint8_t>& out) {
+    FILE* file = std::fopen(path, "rb");
+    if (!file) return false;
+    std::fseek(file, 0, SEEK_END);
+    out.resize(static_cast<size_t>(std::ftell(file)));
+    std::fseek(file, 0, SEEK_SET);
+    const bool ok = std::fread(out.data(), 1, out.size(), file) == out.size();
+    std::fclose(file);
+    return ok;
+}
+
+template <typename Load>
+double timeLoad(int runs, Load load) {
+    auto start = Clock::now();
+    for (int r = 0; r < runs; ++r) load();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / runs;
+}
+
+} // namespace
+
+int main() {
+    const char* path = "level_load_bench.bin";
+    std::printf("%10s %10s %12s %12s %12s\n", "platforms", "file KB", "mmap ms", "read ms", "+grid ms");
+    for (size_t count : { 1000u, 10000u, 100000u }) {
+        const LevelData level = makeScatteredLevel(count);
+        std::vector<uint8_t> encoded;
+        writeLevelBinary(level, encoded);
+        FILE* file = std::fopen(path, "wb");
+        if (!file || std::fwrite(encoded.data(), 1, encoded.size(), file) != encoded.size()) {
+            std::fprintf(stderr, "could not write %s\n", path);
+            return 1;
+        }
+        std::fclose(file);
+
+        LevelData loaded;
+        MappedLevelFile mapped(path);
+        if (!parseLevelBinary(mapped.data(), mapped.size(), loaded) ||
+            !sameRecords(loaded.platforms, level.platforms) || !sameRecords(loaded.goals, level.goals) ||
+            loaded.spawn.x != level.spawn.x || loaded.boundsMax.x != level.boundsMax.x) {
+            std::fprintf(stderr, "decoded level differs at %zu platforms\n", count);
+            return 1;
+        }
+        encoded.resize(encoded.size() - 1);
+        if (parseLevelBinary(encoded.data(), encoded.size(), loaded)) {
+            std::fprintf(stderr, "truncated level accepted at %zu platforms\n", count);
+            return 1;
+        }
+
+        const int runs = static_cast<int>(2000000 / count);
+        double mmapMs = timeLoad(runs, [&] {
+            MappedLevelFile m(path);
+            parseLevelBinary(m.data(), m.size(), loaded);
+        });
+        std::vector<uint8_t> buffer;
+        double readMs = timeLoad(runs, [&] {
+            readWhole(path, buffer);
+            parseLevelBinary(buffer.data(), buffer.size(), loaded);
+        });
+        PlatformGrid grid;
+        double gridMs = timeLoad(runs, [&] {
+            MappedLevelFile m(path);
+            parseLevelBinary(m.data(), m.size(), loaded);
+            grid.build(loaded.platforms);
+        });
+        std::printf("%10zu %10zu %12.3f %12.3f %12.3f\n", count, (encoded.size() + 1) / 1024, mmapMs, readMs, gridMs);
+    }
+    std::remove(path);
+    return 0;
+}
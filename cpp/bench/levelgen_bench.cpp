@@ -0,0 +1,155 @@
+// Procedural level benchmark: generates playable levels of 1k to 1M platforms with
+// LevelGenerator and times, per size, generating the level, writing it as JSON, encoding and
+// loading it through Game::loadLevelBinary (broadphase builds included), and simulating it
+// frame by frame with a bot at the controls. Checks that:
+//   - the same seed gives the same level, bit for bit;
+//   - the bot -- hold right, jump once the body's leading edge runs out of ground -- gets
+//     from the spawn to the goal without falling (levels up to --playthrough platforms);
+//   - asking for 0 platforms still gives a one-platform level with a spawn and a goal.
+// The bench fails if any check does.
+//
+// Usage: levelgen_bench [--platforms N,N,...] [--density D] [--seed S] [--frames F]
+//                       [--playthrough N]   play levels of up to N platforms to the end
+//                       [--json out.json]   save the first level in the public/levels format
+// Build: cmake -S cpp -B build && cmake --build build --target levelgen_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "BenchLevel.hpp"
+#include "Game.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Hold right; jump for one frame when grounded and the ground ends under the leading edge.
+InputState botInput(const Game& game) {
+    const Vec2 position = game.getPlayerPosition();
+    const Vec2 size = game.getPlayerSize();
+    const bool grounded = game.getEntities().grounded[PlayerEntity] != 0;
+    const float feet = position.y - size.y / 2.0f;
+    const bool groundAhead = game.findGroundBelow({ position.x + size.x / 2.0f, feet + 0.05f }, 0.3f).hit;
+    return { false, true, grounded && !groundAhead };
+}
+
+// Steps the bot for `frames` frames; stops early on reaching the goal or falling off.
+struct Run {
+    int frames = 0;
+    bool reachedGoal = false;
+    bool fell = false;
+};
+
+Run playBot(Game& game, int frames) {
+    Run run;
+    for (; run.frames < frames && !run.reachedGoal && !run.fell; ++run.frames) {
+        game.handleInput(botInput(game));
+        game.update(1.0f / 60.0f);
+        game.consumeEvents([&run](const GameEvent& event) { run.reachedGoal |= event.type == EventType::GoalReached; });
+        run.fell = game.getPlayerPosition().y < LevelGenerator::LowestTop - 5.0f;
+    }
+    return run;
+}
+
+bool sameLevel(const LevelData& a, const LevelData& b) {
+    auto same = [](const std::vector<Platform>& x, const std::vector<Platform>& y) {
+        return x.size() == y.size() && std::memcmp(x.data(), y.data(), x.size() * sizeof(Platform)) == 0;
+    };
+    return same(a.platforms, b.platforms) && same(a.goals, b.goals) && std::memcmp(&a.spawn, &b.spawn, sizeof(Vec2)) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<size_t> sizes = { 1000, 10000, 100000, 1000000 };
+    float density = 0.5f;
+    uint32_t seed = 1;
+    int frames = 3000;
+    size_t playthroughLimit = 10000;
+    const char* jsonPath = nullptr;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--platforms") == 0) sizes = parseSizes(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--density") == 0) density = static_cast<float>(std::atof(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--seed") == 0) seed = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        else if (std::strcmp(argv[i], "--frames") == 0) frames = std::max(1, std::atoi(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--playthrough") == 0) playthroughLimit = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--json") == 0) jsonPath = argv[i + 1];
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    Game reference;
+    const MovementLimits limits = reference.getMovementLimits();
+    const LevelData empty = LevelGenerator::generate({ seed, 0, density }, limits);
+    if (empty.platforms.size() != 1 || empty.goals.size() != 1 || !empty.hasSpawn) {
+        std::fprintf(stderr, "a 0-platform request did not give a one-platform level\n");
+        return 1;
+    }
+    std::printf("density %.2f, seed %u, %d simulated frames\n", density, seed, frames);
+    std::printf("%10s %10s %12s %10s %12s %12s %10s %14s\n", "platforms", "length", "generate ms", "JSON MB",
+                "JSON ms", "load ms", "ns/frame", "playthrough f");
+    for (size_t count : sizes) {
+        const GeneratorSettings settings = { seed, static_cast<uint32_t>(count), density };
+        auto start = Clock::now();
+        const LevelData level = LevelGenerator::generate(settings, limits);
+        const double generateMs = msSince(start);
+        if (!sameLevel(level, LevelGenerator::generate(settings, limits))) {
+            std::fprintf(stderr, "generator is not deterministic at %zu platforms\n", count);
+            return 1;
+        }
+
+        std::string json;
+        start = Clock::now();
+        writeLevelJson(level, json);
+        const double jsonMs = msSince(start);
+        if (jsonPath) {
+            FILE* file = std::fopen(jsonPath, "wb");
+            if (!file || std::fwrite(json.data(), 1, json.size(), file) != json.size()) {
+                std::fprintf(stderr, "could not write %s\n", jsonPath);
+                return 1;
+            }
+            std::fclose(file);
+            jsonPath = nullptr;
+        }
+
+        Game game;
+        std::vector<uint8_t> encoded;
+        start = Clock::now();
+        writeLevelBinary(level, encoded);
+        game.loadLevelBinary(encoded.data(), encoded.size());
+        const double loadMs = msSince(start);
+
+        start = Clock::now();
+        const Run timed = playBot(game, frames);
+        const double nsPerFrame = msSince(start) * 1e6 / timed.frames;
+
+        char playthrough[32] = "-";
+        if (count <= playthroughLimit) {
+            Game player;
+            player.loadLevelBinary(encoded.data(), encoded.size());
+            const float length = level.platforms.back().position.x - level.platforms.front().position.x;
+            const Run run = playBot(player, static_cast<int>(length / limits.moveSpeed * 60.0f * 1.5f) + 600);
+            if (!run.reachedGoal) {
+                std::fprintf(stderr, "bot %s at x = %.2f on the %zu-platform level\n", run.fell ? "fell" : "got stuck",
+                             player.getPlayerPosition().x, count);
+                return 1;
+            }
+            std::snprintf(playthrough, sizeof(playthrough), "%d", run.frames);
+        }
+        const float length = level.platforms.back().position.x - level.platforms.front().position.x;
+        std::printf("%10zu %10.0f %12.2f %10.1f %12.2f %12.2f %10.0f %14s\n", count, length, generateMs,
+                    json.size() / (1024.0 * 1024.0), jsonMs, loadMs, nsPerFrame, playthrough);
+    }
+    return 0;
+}
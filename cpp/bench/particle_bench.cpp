@@ -0,0 +1,136 @@
+// Particle benchmark: compares the structure-of-arrays ParticleSystem pool against the
+// original vector<Particle> implementation (erase from the middle on death) at steady
+// states of 1k, 10k and 100k live particles. Both see the same emission stream; the
+// surviving particles are checked for bit-identical state before timings are printed.
+//
+// Build: g++ -O3 -std=c++17 -Icpp/src cpp/bench/particle_bench.cpp -o particle_bench
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "BenchLevel.hpp"
+#include "ParticleSystem.hpp"
+
+namespace {
+
+// ParticleSystem as it was before the pool rewrite.
+struct LegacyParticle {
+    Vec2 position;
+    Vec2 velocity;
+    float life;
+    float maxLife;
+    float size;
+    float rotation;
+    float angularVelocity;
+};
+
+class LegacyParticleSystem {
+public:
+    void update(float deltaTime) {
+        for (auto it = particles.begin(); it != particles.end(); ) {
+            it->life -= deltaTime;
+            if (it->life <= 0) {
+                it = particles.erase(it);
+            } else {
+                it->position.x += it->velocity.x * deltaTime;
+                it->position.y += it->velocity.y * deltaTime;
+                it->rotation += it->angularVelocity * deltaTime;
+                ++it;
+            }
+        }
+    }
+
+    void emit(Vec2 position, Vec2 velocity, float life, float size, float angularVelocity = 0.0f) {
+        particles.push_back({ position, velocity, life, life, size, 0.0f, angularVelocity });
+    }
+
+    std::vector<LegacyParticle> particles;
+};
+
+struct Emission {
+    Vec2 position;
+    Vec2 velocity;
+    float life;
+    float spin;
+};
+
+float unit(uint32_t& state) { return (nextRandom(state) % 10000) / 10000.0f; }
+
+// Lifetimes spread over [0.2, 0.8) s so deaths are scattered through the array every frame,
+// with an emission rate that holds roughly `live` particles alive.
+std::vector<std::vector<Emission>> makeStream(size_t live, int frames, float dt) {
+    const float meanLife = 0.5f;
+    const size_t perFrame = static_cast<size_t>(live * dt / meanLife) + 1;
+    uint32_t seed = 42u;
+    std::vector<std::vector<Emission>> stream(frames);
+    for (auto& batch : stream) {
+        batch.reserve(perFrame);
+        for (size_t i = 0; i < perFrame; ++i) {
+            batch.push_back({ { unit(seed) * 10.0f, unit(seed) * 2.0f },
+                              { unit(seed) * 2.0f - 1.0f, unit(seed) * 2.0f },
+                              0.2f + unit(seed) * 0.6f,
+                              unit(seed) * 10.0f - 5.0f });
+        }
+    }
+    return stream;
+}
+
+template <typename System>
+void emitBatch(System& system, const std::vector<Emission>& batch) {
+    for (const Emission& e : batch) system.emit(e.position, e.velocity, e.life, 0.05f, e.spin);
+}
+
+using Clock = std::chrono::steady_clock;
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const float dt = 1.0f / 60.0f;
+    const size_t targets[] = { 1000, 10000, 100000 };
+    const double budget = argc > 1 ? std::atof(argv[1]) : 1.0; // scales the frame counts
+
+    std::printf("%8s %8s %18s %18s %9s\n", "live", "frames", "legacy ns/frame", "pool ns/frame", "speedup");
+    for (size_t target : targets) {
+        // Warm up for one full lifetime so both systems are at steady state, then time.
+        const int warmup = 60;
+        const int frames = std::max(5, static_cast<int>(budget * 200000.0 / target));
+        auto stream = makeStream(target, warmup + frames, dt);
+
+        LegacyParticleSystem legacy;
+        ParticleSystem pool(target * 2);
+        double legacyNs = 0.0, poolNs = 0.0;
+        for (int f = 0; f < warmup + frames; ++f) {
+            auto t0 = Clock::now();
+            legacy.update(dt);
+            emitBatch(legacy, stream[f]);
+            auto t1 = Clock::now();
+            pool.update(dt);
+            emitBatch(pool, stream[f]);
+            auto t2 = Clock::now();
+            if (f >= warmup) {
+                legacyNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+                poolNs += std::chrono::duration<double, std::nano>(t2 - t1).count();
+            }
+        }
+
+        const ParticleArrays& a = pool.arrays();
+        if (legacy.particles.size() != pool.size() || pool.refusedCount() != 0) {
+            std::fprintf(stderr, "live count mismatch at %zu: legacy %zu pool %zu\n", target, legacy.particles.size(), pool.size());
+            return 1;
+        }
+        for (size_t i = 0; i < pool.size(); ++i) {
+            const LegacyParticle& p = legacy.particles[i];
+            const float expected[] = { p.position.x, p.position.y, p.life, p.rotation };
+            const float actual[] = { a.positionX[i], a.positionY[i], a.life[i], a.rotation[i] };
+            if (std::memcmp(expected, actual, sizeof(expected)) != 0) {
+                std::fprintf(stderr, "particle %zu differs at %zu live\n", i, target);
+                return 1;
+            }
+        }
+        std::printf("%8zu %8d %18.0f %18.0f %8.1fx\n", pool.size(), frames, legacyNs / frames, poolNs / frames, legacyNs / poolNs);
+    }
+    return 0;
+}
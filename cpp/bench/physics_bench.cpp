@@ -0,0 +1,157 @@
+// Physics profile benchmark: ns/frame of the simulation specialized on each built-in tuning
+// profile (StandardPhysics, LowFxPhysics, HighFxPhysics -- constants folded in, emission
+// compiled out where a profile zeroes it) against the Custom profile running the very same
+// values read at run time, with 1 to 1k patrolling entities. Before timing, every pair is
+// checked to be the same simulation: identical state checksums on every frame and identical
+// final snapshots. Low FX must emit no particles, and every profile must move the player and
+// the entities exactly as Standard does. The bench fails if any check does.
+//
+// Usage: physics_bench [--platforms N] [--entities N,N,...] [--frames F] [--repeats R]
+// Build: cmake -S cpp -B build && cmake --build build --target physics_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "BenchLevel.hpp"
+#include "Game.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Variant {
+    const char* name;
+    PhysicsProfile profile;
+    PhysicsTuning values; // what Custom runs for the comparison
+};
+
+const Variant Variants[] = {
+    { "standard", PhysicsProfile::Standard, tuningOf<StandardPhysics>() },
+    { "low-fx", PhysicsProfile::LowFx, tuningOf<LowFxPhysics>() },
+    { "high-fx", PhysicsProfile::HighFx, tuningOf<HighFxPhysics>() },
+};
+
+// Running right with a jump every 44 frames, as game_bench's "run" script.
+InputState inputAt(int frame) {
+    return { false, true, frame % 44 >= 40 };
+}
+
+void setUp(Game& game, const std::vector<uint8_t>& level, uint32_t entities, const Variant& variant, bool specialized) {
+    game.loadLevelBinary(level.data(), level.size());
+    game.setSeed(1);
+    if (specialized) game.setPhysicsProfile(variant.profile);
+    else game.setPhysicsTuning(variant.values);
+    uint32_t seed = 31u;
+    for (uint32_t i = 1; i < entities; ++i) {
+        game.spawnEntity(EntityKind::Enemy, { -8.0f + (nextRandom(seed) % 40000) / 100.0f, 5.0f }, { 0.5f, 0.5f });
+    }
+}
+
+struct Trace {
+    std::vector<uint32_t> checksums;
+    std::vector<uint8_t> finalState;
+    std::vector<float> positions; // every entity's x then y at the end
+    uint32_t maxParticles = 0;
+};
+
+Trace trace(const std::vector<uint8_t>& level, uint32_t entities, const Variant& variant, bool specialized, int frames) {
+    Game game;
+    setUp(game, level, entities, variant, specialized);
+    Trace t;
+    for (int f = 0; f < frames; ++f) {
+        game.handleInput(inputAt(f));
+        game.update(1.0f / 60.0f);
+        game.drainEvents();
+        t.checksums.push_back(game.getStateChecksum());
+        t.maxParticles = std::max(t.maxParticles, game.getParticleCount() + game.getBurstParticleCount());
+    }
+    game.saveState(t.finalState);
+    const EntityStore& store = game.getEntities();
+    t.positions.assign(store.positionX.begin(), store.positionX.begin() + store.size());
+    t.positions.insert(t.positions.end(), store.positionY.begin(), store.positionY.begin() + store.size());
+    return t;
+}
+
+// Returns the name of the first check that failed, or nullptr.
+const char* check(const std::vector<uint8_t>& level, uint32_t entities, int frames) {
+    std::vector<float> standardPositions;
+    for (const Variant& variant : Variants) {
+        const Trace specialized = trace(level, entities, variant, true, frames);
+        const Trace runtime = trace(level, entities, variant, false, frames);
+        if (specialized.checksums != runtime.checksums) return "specialized and run-time checksums differ";
+        if (specialized.finalState != runtime.finalState) return "specialized and run-time final states differ";
+        if (variant.profile == PhysicsProfile::Standard) standardPositions = specialized.positions;
+        else if (specialized.positions != standardPositions) return "profile moved the bodies differently";
+        if (variant.profile == PhysicsProfile::LowFx && specialized.maxParticles != 0) return "low-fx emitted particles";
+    }
+    return nullptr;
+}
+
+struct Timing {
+    double nsPerFrame;
+    double averageParticles;
+};
+
+Timing measure(const std::vector<uint8_t>& level, uint32_t entities, const Variant& variant, bool specialized, int frames) {
+    Game game;
+    setUp(game, level, entities, variant, specialized);
+    uint64_t particleSum = 0;
+    auto start = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        game.handleInput(inputAt(f));
+        game.update(1.0f / 60.0f);
+        game.drainEvents();
+        particleSum += game.getParticleCount() + game.getBurstParticleCount();
+    }
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / frames;
+    return { ns, static_cast<double>(particleSum) / frames };
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t platforms = 1000;
+    std::vector<size_t> entityCounts = { 1, 100, 1000 };
+    int frames = 3000;
+    int repeats = 3;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--platforms") == 0) platforms = std::max<size_t>(1, std::strtoul(argv[i + 1], nullptr, 10));
+        else if (std::strcmp(argv[i], "--entities") == 0) entityCounts = parseSizes(argv[i + 1], 1);
+        else if (std::strcmp(argv[i], "--frames") == 0) frames = std::max(1, std::atoi(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--repeats") == 0) repeats = std::max(1, std::atoi(argv[i + 1]));
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    std::vector<uint8_t> level;
+    writeLevelBinary(makeLevel(platforms), level);
+    std::printf("%zu platforms, %d frames, best of %d; ns/frame\n", platforms, frames, repeats);
+    std::printf("%10s %10s %12s %12s %10s %10s\n", "entities", "profile", "specialized", "run-time", "saved", "particles");
+    for (uint32_t entities : entityCounts) {
+        if (const char* failure = check(level, entities, std::min(frames, 600))) {
+            std::fprintf(stderr, "%u entities: %s\n", entities, failure);
+            return 1;
+        }
+        for (const Variant& variant : Variants) {
+            // Best of `repeats`, alternating the two so drift in machine load hits both alike.
+            Timing specialized = { 1e30, 0.0 };
+            Timing runtime = { 1e30, 0.0 };
+            for (int r = 0; r < repeats; ++r) {
+                const Timing a = measure(level, entities, variant, true, frames);
+                const Timing b = measure(level, entities, variant, false, frames);
+                if (a.nsPerFrame < specialized.nsPerFrame) specialized = a;
+                if (b.nsPerFrame < runtime.nsPerFrame) runtime = b;
+            }
+            std::printf("%10u %10s %12.0f %12.0f %9.1f%% %10.1f\n", entities, variant.name, specialized.nsPerFrame,
+                        runtime.nsPerFrame, 100.0 * (1.0 - specialized.nsPerFrame / runtime.nsPerFrame),
+                        specialized.averageParticles);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,171 @@
+// Platform query benchmark: box overlap, ray cast and nearest-ground-below queries through
+// PlatformSweep against a linear scan of the platform list, on generated levels of 1k to 100k
+// platforms, each once as it is and once with a floor under the whole level listed first.
+// Boxes are camera-sized, rays are 12 units long in random directions (AI line of sight), and
+// ground queries drop up to 10 units. Every sweep result must match the scan exactly -- same
+// platforms, same hit and the same distance bits -- or the bench fails. It also fails if a
+// ground query scans more than MaxScanned boxes on average: one long platform must not make
+// the sweep walk every platform after it.
+//
+// Usage: query_bench [--platforms N,N,...] [--queries Q]
+// Build: cmake -S cpp -B build && cmake --build build --target query_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "BenchLevel.hpp"
+#include "PlatformSweep.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const Vec2 ViewSize = { 11.0f, 6.5f };
+constexpr float RayLength = 12.0f;
+constexpr float GroundDrop = 10.0f;
+constexpr double MaxScanned = 16.0;
+
+Aabb boxOf(const Platform& p) {
+    return { { p.position.x - p.size.x / 2.0f, p.position.y - p.size.y / 2.0f },
+             { p.position.x + p.size.x / 2.0f, p.position.y + p.size.y / 2.0f } };
+}
+
+// The scans every caller used to write.
+void scanOverlaps(const std::vector<Platform>& platforms, const Aabb& box, std::vector<uint32_t>& out) {
+    out.clear();
+    for (uint32_t i = 0; i < platforms.size(); ++i) {
+        const Aabb b = boxOf(platforms[i]);
+        if (b.min.x < box.max.x && b.max.x > box.min.x && b.min.y < box.max.y && b.max.y > box.min.y) out.push_back(i);
+    }
+}
+
+RayHit scanRaycast(const std::vector<Platform>& platforms, const Vec2& origin, const Vec2& direction, float maxDistance) {
+    RayHit result = { false, 0, 0.0f, { 0.0f, 0.0f }, { 0.0f, 0.0f } };
+    for (uint32_t i = 0; i < platforms.size(); ++i) {
+        float t;
+        Vec2 normal;
+        if (!PlatformSweep::enter(boxOf(platforms[i]), origin, direction, maxDistance, t, normal)) continue;
+        if (result.hit && t >= result.distance) continue;
+        result = { true, i, t, { origin.x + direction.x * t, origin.y + direction.y * t }, normal };
+    }
+    return result;
+}
+
+RayHit scanGroundBelow(const std::vector<Platform>& platforms, const Vec2& point, float maxDistance) {
+    RayHit result = { false, 0, 0.0f, { 0.0f, 0.0f }, { 0.0f, 0.0f } };
+    const float toY = point.y - maxDistance;
+    for (uint32_t i = 0; i < platforms.size(); ++i) {
+        const Aabb b = boxOf(platforms[i]);
+        if (!(b.min.x < point.x && b.max.x > point.x && b.min.y < point.y && b.max.y > toY)) continue;
+        const float top = std::min(b.max.y, point.y);
+        if (result.hit && top <= result.point.y) continue;
+        result = { true, i, point.y - top, { point.x, top }, { 0.0f, b.max.y <= point.y ? 1.0f : 0.0f } };
+    }
+    return result;
+}
+
+bool sameHit(const RayHit& a, const RayHit& b) {
+    if (a.hit != b.hit) return false;
+    return !a.hit || (a.platform == b.platform && std::memcmp(&a.distance, &b.distance, sizeof(float)) == 0 &&
+                      std::memcmp(&a.point, &b.point, sizeof(Vec2)) == 0 && std::memcmp(&a.normal, &b.normal, sizeof(Vec2)) == 0);
+}
+
+struct Query {
+    Vec2 point;
+    Vec2 direction; // unit
+};
+
+std::vector<Query> makeQueries(size_t count, float levelWidth) {
+    std::vector<Query> queries(count);
+    uint32_t seed = 777u;
+    for (Query& q : queries) {
+        q.point = { -10.0f + levelWidth * (nextRandom(seed) % 100000) / 100000.0f, -3.0f + (nextRandom(seed) % 700) / 100.0f };
+        const float angle = (nextRandom(seed) % 6283) / 1000.0f;
+        q.direction = { std::cos(angle), std::sin(angle) };
+    }
+    return queries;
+}
+
+template <typename Fn>
+double nsPerQuery(const std::vector<Query>& queries, Fn fn) {
+    auto start = Clock::now();
+    for (const Query& q : queries) fn(q);
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / queries.size();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<size_t> sizes = { 1000, 10000, 100000 };
+    size_t queryCount = 1000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--platforms") == 0) sizes = parseSizes(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--queries") == 0) queryCount = std::max<size_t>(1, std::strtoul(argv[i + 1], nullptr, 10));
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    std::printf("%d queries of each kind, ns/query; scanned = boxes a ground query looks at\n", static_cast<int>(queryCount));
+    std::printf("%10s %6s %12s %12s %12s %12s %12s %12s %8s\n", "platforms", "floor", "box scan", "box sweep", "ray scan",
+                "ray sweep", "ground scan", "ground sweep", "scanned");
+    for (size_t count : sizes)
+    for (bool longFloor : { false, true }) {
+        const std::vector<Platform> platforms = makeLevel(count, longFloor).platforms;
+        PlatformSweep sweep;
+        sweep.build(platforms);
+        const std::vector<Query> queries = makeQueries(queryCount, 20.0f * (count / 8 + 1));
+        auto viewAt = [](const Vec2& p) {
+            return Aabb{ { p.x - ViewSize.x / 2.0f, p.y - ViewSize.y / 2.0f }, { p.x + ViewSize.x / 2.0f, p.y + ViewSize.y / 2.0f } };
+        };
+
+        // Check first, on the same queries the timings use.
+        std::vector<uint32_t> expected, got;
+        for (size_t i = 0; i < queries.size(); ++i) {
+            const Query& q = queries[i];
+            scanOverlaps(platforms, viewAt(q.point), expected);
+            got.clear();
+            sweep.forEachOverlap(viewAt(q.point), [&got](uint32_t platform) { got.push_back(platform); });
+            std::sort(got.begin(), got.end());
+            const bool boxes = got == expected && sweep.anyOverlap(viewAt(q.point)) == !expected.empty();
+            const bool rays = sameHit(sweep.raycast(q.point, q.direction, RayLength), scanRaycast(platforms, q.point, q.direction, RayLength));
+            const bool ground = sameHit(sweep.groundBelow(q.point, GroundDrop), scanGroundBelow(platforms, q.point, GroundDrop));
+            if (!boxes || !rays || !ground) {
+                std::fprintf(stderr, "%s query %zu differs from the scan at %zu platforms%s\n",
+                             !boxes ? "box" : !rays ? "ray" : "ground", i, count, longFloor ? " with a floor" : "");
+                return 1;
+            }
+        }
+        uint32_t scanned = 0;
+        for (const Query& q : queries) sweep.castDown(q.point.x, q.point.x, q.point.y, q.point.y - GroundDrop, &scanned);
+        const double scannedPerQuery = static_cast<double>(scanned) / queries.size();
+        if (scannedPerQuery > MaxScanned) {
+            std::fprintf(stderr, "ground queries scan %.1f boxes each at %zu platforms%s (budget %.0f)\n", scannedPerQuery,
+                         count, longFloor ? " with a floor" : "", MaxScanned);
+            return 1;
+        }
+
+        uint64_t sink = 0;
+        const double boxScan = nsPerQuery(queries, [&](const Query& q) {
+            scanOverlaps(platforms, viewAt(q.point), expected);
+            sink += expected.size();
+        });
+        const double boxSweep = nsPerQuery(queries, [&](const Query& q) {
+            sweep.forEachOverlap(viewAt(q.point), [&sink](uint32_t platform) { sink += platform; });
+        });
+        const double rayScan = nsPerQuery(queries, [&](const Query& q) { sink += scanRaycast(platforms, q.point, q.direction, RayLength).platform; });
+        const double raySweep = nsPerQuery(queries, [&](const Query& q) { sink += sweep.raycast(q.point, q.direction, RayLength).platform; });
+        const double groundScan = nsPerQuery(queries, [&](const Query& q) { sink += scanGroundBelow(platforms, q.point, GroundDrop).platform; });
+        const double groundSweep = nsPerQuery(queries, [&](const Query& q) { sink += sweep.groundBelow(q.point, GroundDrop).platform; });
+        std::printf("%10zu %6s %12.0f %12.0f %12.0f %12.0f %12.0f %12.0f %8.1f\n", count, longFloor ? "yes" : "no", boxScan,
+                    boxSweep, rayScan, raySweep, groundScan, groundSweep, scannedPerQuery);
+        if (sink == 1) std::printf("\n"); // keeps the timed loops from being optimized away
+    }
+    return 0;
+}
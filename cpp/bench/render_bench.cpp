@@ -0,0 +1,228 @@
+// Render-buffer benchmark, on levels of 1k, 10k and 100k platforms with a few hundred enemies
+// and a running player kicking up particles. Per frame it times Game::buildRenderBuffer
+// (culled entities and particles packed into one instance buffer) plus the static platform
+// run lookup, against a brute-force pass over everything, and checks:
+//   - the buffer holds exactly the sprites overlapping the view, in source order, with the
+//     expected fields (particle alpha = life / maxLife). Burst particles are expected from
+//     every particle of every burst, so culling a whole burst must never drop a visible one;
+//   - the static platform layer is sorted by left edge within each width class, matches the
+//     platform list, is not rebuilt while the geometry revision stands still, and its runs for
+//     the view contain every visible platform;
+//   - those runs stay bounded by the view (MaxRangeSprites) even though the level is laid
+//     over a floor as long as the level itself, both along the run and at the level's far end.
+// The bench fails on any mismatch.
+//
+// Usage: render_bench [--platforms N,N,...] [--frames F]
+// Build: cmake -S cpp -B build && cmake --build build --target render_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "BenchLevel.hpp"
+#include "Game.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const Vec2 ViewSize = { 11.0f, 6.5f };
+// Most static sprites the runs for one view may hold, whatever the level size.
+const uint32_t MaxRangeSprites = 32;
+
+// Camera box the game culls against: previous and current frame merged.
+Aabb viewOf(const Game& game) {
+    return PlatformGrid::merge(PlatformGrid::boxOf(game.getPreviousCameraPosition(), ViewSize),
+                               PlatformGrid::boxOf(game.getCameraPosition(), ViewSize));
+}
+
+// What buildRenderBuffer should produce, from a plain scan of every entity and particle.
+std::vector<SpriteInstance> bruteForce(const Game& game, uint32_t counts[RenderBatchCount]) {
+    const Aabb view = viewOf(game);
+    std::vector<SpriteInstance> out;
+    const EntityStore& e = game.getEntities();
+    for (uint32_t i = 1; i < e.size(); ++i) {
+        if (!RenderBuffer::overlaps(PlatformGrid::boxOf(e.position(i), e.size(i)), view)) continue;
+        out.push_back({ e.position(i), e.size(i), 0.0f, 1.0f, { static_cast<float>(e.state[i]), static_cast<float>(e.kind[i]) } });
+    }
+    counts[0] = static_cast<uint32_t>(out.size());
+    const ParticleView pv = game.getParticleView();
+    auto field = [](uintptr_t ptr) { return reinterpret_cast<const float*>(ptr); };
+    for (uint32_t i = 0; i < pv.count; ++i) {
+        const Vec2 position = { field(pv.positionX)[i], field(pv.positionY)[i] };
+        const float size = field(pv.size)[i];
+        const float reach = size * 0.7072f;
+        if (!RenderBuffer::overlaps({ { position.x - reach, position.y - reach }, { position.x + reach, position.y + reach } }, view)) continue;
+        out.push_back({ position, { size, size }, field(pv.rotation)[i], field(pv.life)[i] / field(pv.maxLife)[i], { 0.0f, 0.0f } });
+    }
+    const BurstSystem& bursts = game.getBursts();
+    for (const ParticleBurst& b : bursts.data()) {
+        const float reach = b.size * 0.7072f;
+        for (uint32_t k = 0; k < b.count; ++k) {
+            const BurstParticle p = BurstSystem::particleAt(b, k, bursts.ageOf(b));
+            if (!RenderBuffer::overlaps({ { p.position.x - reach, p.position.y - reach }, { p.position.x + reach, p.position.y + reach } }, view)) continue;
+            out.push_back({ p.position, { b.size, b.size }, p.rotation, p.alpha, { 0.0f, 0.0f } });
+        }
+    }
+    counts[1] = static_cast<uint32_t>(out.size()) - counts[0];
+    return out;
+}
+
+// The static layer must be the platform list sorted by width class, then by left edge within
+// each class, one sprite per platform.
+bool layerMatchesPlatforms(const Game& game) {
+    const StaticSpriteLayer& layer = game.getStaticSprites();
+    const std::vector<Platform>& platforms = game.getPlatforms();
+    const std::vector<SpriteInstance>& sprites = layer.data();
+    if (sprites.size() != platforms.size() || layer.revision() != game.getPlatformRevision()) return false;
+    std::vector<uint8_t> seen(platforms.size(), 0);
+    std::vector<uint32_t> classOf;
+    widthClasses(platforms, classOf);
+    uint32_t c = 0;
+    for (uint32_t s = 0; s < sprites.size(); ++s) {
+        const uint32_t i = layer.platformIndex(s);
+        if (i >= platforms.size() || seen[i]++) return false;
+        const SpriteInstance expected = { platforms[i].position, platforms[i].size, 0.0f, 1.0f, { 0.0f, 0.0f } };
+        if (std::memcmp(&sprites[s], &expected, sizeof(SpriteInstance)) != 0) return false;
+        while (c < layer.classCount() && s >= layer.classRange(c).start + layer.classRange(c).count) ++c;
+        if (c == layer.classCount() || classOf[i] != c) return false;
+        if (s > layer.classRange(c).start) {
+            const SpriteInstance& prev = sprites[s - 1];
+            if (prev.position.x - prev.size.x / 2.0f > sprites[s].position.x - sprites[s].size.x / 2.0f) return false;
+        }
+    }
+    return true;
+}
+
+// Sprites in the runs for a view centred on the last platform laid down, at the far end of the
+// level with nearly every other platform to the left of the view.
+uint32_t farEndRangeSprites(Game& game) {
+    const float x = game.getPlatforms().back().position.x;
+    uint32_t sprites = 0;
+    const uint32_t runs = game.findStaticSpriteRanges(x - ViewSize.x / 2.0f, x + ViewSize.x / 2.0f);
+    for (uint32_t r = 0; r < runs; ++r) sprites += game.getStaticSpriteRange(r).count;
+    return sprites;
+}
+
+// Every platform overlapping the view must sit inside one of the layer's runs for it.
+bool rangesCoverView(const Game& game, const std::vector<SpriteRange>& runs) {
+    const Aabb view = viewOf(game);
+    const StaticSpriteLayer& layer = game.getStaticSprites();
+    const std::vector<Platform>& platforms = game.getPlatforms();
+    for (uint32_t s = 0; s < layer.data().size(); ++s) {
+        const Platform& p = platforms[layer.platformIndex(s)];
+        if (!RenderBuffer::overlaps(PlatformGrid::boxOf(p.position, p.size), view)) continue;
+        auto inside = [s](const SpriteRange& r) { return s >= r.start && s < r.start + r.count; };
+        if (std::none_of(runs.begin(), runs.end(), inside)) return false;
+    }
+    return true;
+}
+
+bool matches(const RenderBuffer& buffer, const std::vector<SpriteInstance>& expected, const uint32_t counts[RenderBatchCount]) {
+    const std::vector<SpriteInstance>& got = buffer.data();
+    if (got.size() != expected.size()) return false;
+    uint32_t start = 0;
+    for (uint32_t b = 0; b < RenderBatchCount; ++b) {
+        const RenderBatch batch = static_cast<RenderBatch>(b);
+        if (buffer.batchStart(batch) != start || buffer.batchCount(batch) != counts[b]) return false;
+        start += counts[b];
+    }
+    return got.empty() || std::memcmp(got.data(), expected.data(), got.size() * sizeof(SpriteInstance)) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<size_t> sizes = { 1000, 10000, 100000 };
+    int frames = 2000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--platforms") == 0) sizes = parseSizes(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--frames") == 0) frames = std::max(1, std::atoi(argv[i + 1]));
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    std::printf("%10s %12s %12s %14s %14s %10s\n", "platforms", "platf range", "instances", "build ns", "scan-all ns", "speedup");
+    for (size_t count : sizes) {
+        std::vector<uint8_t> level;
+        writeLevelBinary(makeLevel(count), level);
+        Game game;
+        game.loadLevelBinary(level.data(), level.size());
+        game.setSeed(1);
+        uint32_t seed = 31u;
+        for (int i = 0; i < 300; ++i) {
+            game.spawnEntity(EntityKind::Enemy, { -8.0f + (nextRandom(seed) % 8000) / 100.0f, 5.0f }, { 0.5f, 0.5f });
+        }
+        if (!layerMatchesPlatforms(game)) {
+            std::fprintf(stderr, "static platform layer does not match the level at %zu platforms\n", count);
+            return 1;
+        }
+        const uint32_t farEnd = farEndRangeSprites(game);
+        if (farEnd > MaxRangeSprites) {
+            std::fprintf(stderr, "static runs hold %u sprites for the far end at %zu platforms (budget %u)\n",
+                         farEnd, count, MaxRangeSprites);
+            return 1;
+        }
+        const uint32_t revision = game.getPlatformRevision();
+        const StaticSpriteView layerView = game.getStaticSpriteView();
+
+        const InputState right{ false, true, false };
+        const InputState rightJump{ false, true, true };
+        double buildNs = 0.0, scanNs = 0.0;
+        uint64_t instances = 0, rangeSprites = 0;
+        uint32_t mostRangeSprites = 0;
+        std::vector<SpriteRange> runs;
+        for (int f = 0; f < frames; ++f) {
+            game.handleInput(f % 44 < 40 ? right : rightJump);
+            game.update(1.0f / 60.0f);
+            game.drainEvents();
+
+            auto start = Clock::now();
+            const RenderView view = game.buildRenderBuffer(ViewSize.x, ViewSize.y);
+            const Aabb visible = viewOf(game);
+            const uint32_t runCount = game.hasGeometryChanged(revision) ? 0 : game.findStaticSpriteRanges(visible.min.x, visible.max.x);
+            auto built = Clock::now();
+            uint32_t counts[RenderBatchCount];
+            const std::vector<SpriteInstance> expected = bruteForce(game, counts);
+            auto scanned = Clock::now();
+            buildNs += std::chrono::duration<double, std::nano>(built - start).count();
+            scanNs += std::chrono::duration<double, std::nano>(scanned - built).count();
+            instances += view.total;
+            runs.clear();
+            uint32_t runSprites = 0;
+            for (uint32_t r = 0; r < runCount; ++r) {
+                runs.push_back(game.getStaticSpriteRange(r));
+                runSprites += runs.back().count;
+            }
+            rangeSprites += runSprites;
+            mostRangeSprites = std::max(mostRangeSprites, runSprites);
+
+            const StaticSpriteView now = game.getStaticSpriteView();
+            if (game.hasGeometryChanged(revision) || now.ptr != layerView.ptr || now.revision != revision ||
+                !rangesCoverView(game, runs)) {
+                std::fprintf(stderr, "static platform layer wrong at %zu platforms, frame %d\n", count, f);
+                return 1;
+            }
+
+            if (!matches(game.getRenderBuffer(), expected, counts) || view.total != expected.size() ||
+                view.ptr != reinterpret_cast<uintptr_t>(game.getRenderBuffer().data().data())) {
+                std::fprintf(stderr, "render buffer mismatch at %zu platforms, frame %d\n", count, f);
+                return 1;
+            }
+            if (runSprites > MaxRangeSprites) {
+                std::fprintf(stderr, "static runs hold %u sprites for one view at %zu platforms (budget %u)\n",
+                             runSprites, count, MaxRangeSprites);
+                return 1;
+            }
+        }
+        std::printf("%10zu %12.1f %12.1f %14.0f %14.0f %9.1fx\n", count, static_cast<double>(rangeSprites) / frames,
+                    static_cast<double>(instances) / frames,
+                    buildNs / frames, scanNs / frames, scanNs / buildNs);
+    }
+    return 0;
+}
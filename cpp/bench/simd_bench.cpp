@@ -0,0 +1,149 @@
+// SIMD kernel benchmark, built at -O3 like the browser build. Particle integration: the plain
+// loop in Simd.hpp, as the compiler vectorizes it, against the hand-written 4-wide kernel it
+// replaced (kept here). AABB overlap: overlapMask4 against its scalar reference. Each pair is
+// checked to match bit for bit before it is timed; on AArch64 build with -ffp-contract=off,
+// or the compiler may fuse the loop's multiply-adds and move positions by an ulp.
+//
+// Build: g++ -O3 -std=c++17 -Icpp/src cpp/bench/simd_bench.cpp -o simd_bench
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "BenchLevel.hpp"
+#include "Simd.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+float unit(uint32_t& state) { return (nextRandom(state) % 100000) / 100000.0f; }
+
+struct Particles {
+    std::vector<float> px, py, rotation, life, vx, vy, spin;
+    explicit Particles(size_t n) : px(n), py(n), rotation(n), life(n), vx(n), vy(n), spin(n) {
+        uint32_t seed = 7u;
+        for (size_t i = 0; i < n; ++i) {
+            px[i] = unit(seed) * 100.0f;
+            py[i] = unit(seed) * 10.0f;
+            rotation[i] = 0.0f;
+            life[i] = unit(seed);
+            vx[i] = unit(seed) * 4.0f - 2.0f;
+            vy[i] = unit(seed) * 4.0f - 2.0f;
+            spin[i] = unit(seed) * 10.0f - 5.0f;
+        }
+    }
+};
+
+// The hand-written integrator Simd.hpp used to ship: 4 particles per step, scalar tail.
+void integrateParticles4(size_t n, float deltaTime, float* __restrict px, float* __restrict py,
+                         float* __restrict rotation, float* __restrict life, const float* __restrict vx,
+                         const float* __restrict vy, const float* __restrict spin) {
+    size_t i = 0;
+#if PLATFORMER_SIMD && defined(__wasm_simd128__)
+    const v128_t dt = wasm_f32x4_splat(deltaTime);
+    for (; i + 4 <= n; i += 4) {
+        wasm_v128_store(life + i, wasm_f32x4_sub(wasm_v128_load(life + i), dt));
+        wasm_v128_store(px + i, wasm_f32x4_add(wasm_v128_load(px + i), wasm_f32x4_mul(wasm_v128_load(vx + i), dt)));
+        wasm_v128_store(py + i, wasm_f32x4_add(wasm_v128_load(py + i), wasm_f32x4_mul(wasm_v128_load(vy + i), dt)));
+        wasm_v128_store(rotation + i, wasm_f32x4_add(wasm_v128_load(rotation + i), wasm_f32x4_mul(wasm_v128_load(spin + i), dt)));
+    }
+#elif PLATFORMER_SIMD && defined(__SSE2__)
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), dt));
+        _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(_mm_loadu_ps(vx + i), dt)));
+        _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(_mm_loadu_ps(vy + i), dt)));
+        _mm_storeu_ps(rotation + i, _mm_add_ps(_mm_loadu_ps(rotation + i), _mm_mul_ps(_mm_loadu_ps(spin + i), dt)));
+    }
+#elif PLATFORMER_SIMD && defined(__ARM_NEON)
+    const float32x4_t dt = vdupq_n_f32(deltaTime);
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(life + i, vsubq_f32(vld1q_f32(life + i), dt));
+        vst1q_f32(px + i, vaddq_f32(vld1q_f32(px + i), vmulq_f32(vld1q_f32(vx + i), dt)));
+        vst1q_f32(py + i, vaddq_f32(vld1q_f32(py + i), vmulq_f32(vld1q_f32(vy + i), dt)));
+        vst1q_f32(rotation + i, vaddq_f32(vld1q_f32(rotation + i), vmulq_f32(vld1q_f32(spin + i), dt)));
+    }
+#endif
+    integrateParticles(n - i, deltaTime, px + i, py + i, rotation + i, life + i, vx + i, vy + i, spin + i);
+}
+
+template <typename Kernel>
+double timeIntegrate(Particles& p, int frames, Kernel kernel) {
+    const size_t n = p.px.size();
+    auto start = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        kernel(n, 1.0f / 60.0f, p.px.data(), p.py.data(), p.rotation.data(), p.life.data(), p.vx.data(), p.vy.data(), p.spin.data());
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / frames;
+}
+
+bool sameBits(const std::vector<float>& a, const std::vector<float>& b) {
+    return std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+} // namespace
+
+int main() {
+    std::printf("backend: %s\n", PLATFORMER_SIMD ?
+#if defined(__wasm_simd128__)
+        "wasm simd128"
+#elif defined(__SSE2__)
+        "sse2"
+#elif defined(__ARM_NEON)
+        "neon"
+#else
+        "none"
+#endif
+        : "scalar (PLATFORMER_SIMD=0)");
+
+    std::printf("%10s %18s %18s\n", "particles", "loop ns/frame", "4-wide ns/frame");
+    for (size_t n : { 1000u, 10000u, 100000u }) {
+        Particles loop(n + 3), wide(n + 3); // odd length exercises the scalar tail
+        const int frames = static_cast<int>(20000000 / n);
+        double loopNs = timeIntegrate(loop, frames, integrateParticles);
+        double wideNs = timeIntegrate(wide, frames, integrateParticles4);
+        if (!sameBits(loop.px, wide.px) || !sameBits(loop.py, wide.py) ||
+            !sameBits(loop.rotation, wide.rotation) || !sameBits(loop.life, wide.life)) {
+            std::fprintf(stderr, "integration results differ at %zu particles\n", n);
+            return 1;
+        }
+        std::printf("%10zu %18.0f %18.0f\n", n + 3, loopNs, wideNs);
+    }
+
+    // Overlap masks: a player-sized box against random boxes, including exact edge contacts.
+    const size_t boxes = 1 << 16;
+    std::vector<float> minX(boxes), minY(boxes), maxX(boxes), maxY(boxes);
+    uint32_t seed = 99u;
+    for (size_t i = 0; i < boxes; ++i) {
+        minX[i] = unit(seed) * 4.0f - 2.0f;
+        minY[i] = unit(seed) * 4.0f - 2.0f;
+        maxX[i] = (i % 7 == 0) ? -0.25f : minX[i] + unit(seed) * 2.0f; // touching edge
+        maxY[i] = minY[i] + unit(seed) * 0.5f;
+    }
+    const Aabb player = { { -0.25f, -0.4f }, { 0.25f, 0.4f } };
+    unsigned scalarHits = 0, simdHits = 0;
+    const int rounds = 200;
+    auto t0 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (size_t i = 0; i < boxes; i += 4)
+            scalarHits += overlapMask4Scalar(player, &minX[i], &minY[i], &maxX[i], &maxY[i]);
+    auto t1 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (size_t i = 0; i < boxes; i += 4)
+            simdHits += overlapMask4(player, &minX[i], &minY[i], &maxX[i], &maxY[i]);
+    auto t2 = Clock::now();
+    for (size_t i = 0; i < boxes; i += 4) {
+        if (overlapMask4Scalar(player, &minX[i], &minY[i], &maxX[i], &maxY[i]) !=
+            overlapMask4(player, &minX[i], &minY[i], &maxX[i], &maxY[i])) {
+            std::fprintf(stderr, "overlap masks differ at box %zu\n", i);
+            return 1;
+        }
+    }
+    const double tests = static_cast<double>(rounds) * boxes;
+    std::printf("aabb tests: scalar %.2f ns/test, simd %.2f ns/test (checksums %u/%u)\n",
+                std::chrono::duration<double, std::nano>(t1 - t0).count() / tests,
+                std::chrono::duration<double, std::nano>(t2 - t1).count() / tests, scalarHits, simdHits);
+    return 0;
+}
@@ -0,0 +1,281 @@
+// Snapshot benchmark: times Game::saveState / Game::restoreState with 1 to 10k entities and the
+// player's live particles, next to reloading the level (the old way to restart). Level geometry is
+// not part of a snapshot, so its size only follows the entity and particle counts. For every
+// row the bench first checks the round trip, as rollback netcode would use it:
+//   - restoring a snapshot gives back the same checksum, and saving again gives the same bytes;
+//   - resimulating the same inputs from the restored state reproduces every later frame's
+//     checksum and the final state byte for byte;
+//   - the snapshot restores onto a freshly loaded Game of the same level;
+//   - a truncated snapshot, one taken on another level, or one with an out-of-range burst,
+//     entity kind or player state is refused and changes nothing.
+// Before the table it checks instant retry on a chunked level: a snapshot taken right after
+// loading (before any chunk arrived) and one taken on a triggered goal both restore after
+// chunks have streamed, and give back the same bytes.
+// It also fails if saving into a reused buffer or restoring allocates.
+//
+// Usage: snapshot_bench [--platforms N] [--entities N,N,...] [--iterations I]
+// Build: cmake -S cpp -B build && cmake --build build --target snapshot_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <vector>
+#include "AllocationHook.hpp"
+#include "BenchLevel.hpp"
+#include "Game.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int WarmupFrames = 300;   // frames played before the snapshot
+constexpr int RollbackFrames = 120; // frames resimulated after restoring
+// Snapshot layout, for corrupting single fields: the scalar block (three Vec2s, three floats,
+// the burst clock, the RNG state, two uint32s and four flag bytes), then the entity arrays,
+// which start with six float and three byte components.
+constexpr size_t ScalarBytes = 64;
+constexpr size_t EntityBytesBeforeKind = 6 * sizeof(float) + 3;
+
+// Running right with a jump every 44 frames, so particles keep being emitted.
+InputState inputAt(int frame) {
+    return { false, true, frame % 44 >= 40 };
+}
+
+void play(Game& game, int first, int count, std::vector<uint32_t>* checksums = nullptr) {
+    for (int f = first; f < first + count; ++f) {
+        game.handleInput(inputAt(f));
+        game.update(1.0f / 60.0f);
+        game.drainEvents();
+        if (checksums) checksums->push_back(game.getStateChecksum());
+    }
+}
+
+void loadGame(Game& game, const std::vector<uint8_t>& level, uint32_t entities) {
+    game.loadLevelBinary(level.data(), level.size());
+    game.setSeed(1);
+    uint32_t seed = 31u;
+    for (uint32_t i = 1; i < entities; ++i) {
+        const bool enemy = i % 4 != 0;
+        game.spawnEntity(enemy ? EntityKind::Enemy : EntityKind::Collectible,
+                         { -8.0f + (nextRandom(seed) % 40000) / 100.0f, enemy ? 5.0f : -1.0f }, { 0.5f, 0.5f });
+    }
+}
+
+// Returns the name of the first check that failed, or nullptr.
+const char* checkRoundTrip(const std::vector<uint8_t>& level, uint32_t entities) {
+    Game game;
+    loadGame(game, level, entities);
+    play(game, 0, WarmupFrames);
+    std::vector<uint8_t> snapshot;
+    game.saveState(snapshot);
+    const uint32_t savedChecksum = game.getStateChecksum();
+    std::vector<uint32_t> expected;
+    play(game, WarmupFrames, RollbackFrames, &expected);
+    std::vector<uint8_t> finalState;
+    game.saveState(finalState);
+
+    // Rewind and resimulate.
+    if (!game.restoreState(snapshot.data(), snapshot.size())) return "restore refused";
+    if (game.getStateChecksum() != savedChecksum) return "checksum after restore";
+    std::vector<uint8_t> again;
+    game.saveState(again);
+    if (again != snapshot) return "re-saved snapshot differs";
+    std::vector<uint32_t> resimulated;
+    play(game, WarmupFrames, RollbackFrames, &resimulated);
+    if (resimulated != expected) return "resimulated checksums";
+    game.saveState(again);
+    if (again != finalState) return "resimulated final state";
+
+    // A different Game on the same level.
+    Game fresh;
+    fresh.loadLevelBinary(level.data(), level.size());
+    if (!fresh.restoreState(snapshot.data(), snapshot.size()) || fresh.getStateChecksum() != savedChecksum) {
+        return "restore onto a fresh Game";
+    }
+    fresh.saveState(again);
+    if (again != snapshot) return "fresh Game state differs";
+
+    Game other;
+    other.loadGeneratedLevel(7, 100, 1.0f);
+    if (other.restoreState(snapshot.data(), snapshot.size())) return "snapshot of another level accepted";
+
+    // Bad input leaves the game untouched.
+    const uint32_t before = game.getStateChecksum();
+    if (game.restoreState(snapshot.data(), snapshot.size() - 1)) return "truncated snapshot accepted";
+    SnapshotHeader header;
+    readSnapshotHeader(snapshot.data(), snapshot.size(), header);
+    if (header.burstCount == 0) return "no bursts to corrupt";
+    const size_t flagsAt = SnapshotHeaderSize + ScalarBytes - 4;
+    const size_t kindsAt = SnapshotHeaderSize + ScalarBytes + header.entityCount * EntityBytesBeforeKind;
+    const size_t burstsAt = snapshot.size() - header.goalCount * sizeof(Vec2) - header.burstCount * sizeof(ParticleBurst);
+    const uint32_t otherLevel = header.level + 1, badKind = 9, collectibleKind = static_cast<uint32_t>(EntityKind::Collectible), badCount = BurstSystem::MaxBurstSize + 1;
+    const float badLifetime = 0.0f;
+    const uint8_t badState = 4;
+    const struct { size_t offset; const void* value; size_t size; const char* failure; } corruptions[] = {
+        { 12, &otherLevel, sizeof(otherLevel), "snapshot of another level identity accepted" },
+        { flagsAt + 2, &badState, sizeof(badState), "out-of-range player state accepted" },
+        { kindsAt, &badKind, sizeof(badKind), "out-of-range entity kind accepted" },
+        { kindsAt + header.entityCount * sizeof(uint32_t), &badKind, sizeof(badKind), "out-of-range entity state accepted" },
+        { kindsAt, &collectibleKind, sizeof(collectibleKind), "snapshot without a player accepted" },
+        { burstsAt + offsetof(ParticleBurst, count), &badCount, sizeof(badCount), "oversized burst accepted" },
+        { burstsAt + offsetof(ParticleBurst, lifetime), &badLifetime, sizeof(badLifetime), "burst without lifetime accepted" },
+    };
+    for (const auto& c : corruptions) {
+        std::vector<uint8_t> corrupt = snapshot;
+        std::memcpy(corrupt.data() + c.offset, c.value, c.size);
+        if (game.restoreState(corrupt.data(), corrupt.size())) return c.failure;
+    }
+    if (game.getStateChecksum() != before) return "refused restore changed the state";
+    return nullptr;
+}
+
+// A chunked version of makeLevel with a goal under the spawn point: the manifest, and each
+// chunk's records (every record touching the chunk, as scripts/level-binary.mjs splits them).
+struct ChunkedLevel {
+    std::vector<uint8_t> manifest;
+    std::vector<std::vector<uint8_t>> chunks; // chunk k at index k - firstChunk
+    int32_t firstChunk;
+};
+
+ChunkedLevel makeChunkedLevel(size_t count, float width) {
+    LevelData whole = makeLevel(count);
+    whole.goals.push_back({ { 0.0f, -1.5f }, { 1.0f, 1.0f } });
+    LevelData manifest;
+    manifest.hasSpawn = true;
+    manifest.spawn = whole.spawn;
+    manifest.hasBounds = true;
+    manifest.boundsMin = { -10.0f, -10.0f };
+    manifest.boundsMax = { -10.0f + 20.0f * (count / 8 + 1), 10.0f };
+    manifest.chunkWidth = width;
+    ChunkedLevel level;
+    writeLevelBinary(manifest, level.manifest);
+    level.firstChunk = static_cast<int32_t>(std::floor(manifest.boundsMin.x / width));
+    const int32_t lastChunk = static_cast<int32_t>(std::floor(manifest.boundsMax.x / width));
+    for (int32_t k = level.firstChunk; k <= lastChunk; ++k) {
+        auto touches = [k, width](const Platform& p) {
+            return p.position.x + p.size.x / 2.0f >= k * width && p.position.x - p.size.x / 2.0f < (k + 1) * width;
+        };
+        LevelData chunk;
+        std::copy_if(whole.platforms.begin(), whole.platforms.end(), std::back_inserter(chunk.platforms), touches);
+        std::copy_if(whole.goals.begin(), whole.goals.end(), std::back_inserter(chunk.goals), touches);
+        level.chunks.emplace_back();
+        writeLevelBinary(chunk, level.chunks.back());
+    }
+    return level;
+}
+
+void streamChunks(Game& game, const ChunkedLevel& level) {
+    while (game.getRequestedChunkCount() > 0) {
+        const int32_t k = game.getRequestedChunk(0);
+        const std::vector<uint8_t>& chunk = level.chunks[k - level.firstChunk];
+        game.loadChunkBinary(k, chunk.data(), chunk.size());
+    }
+}
+
+// Standing still, streaming whatever is requested each frame.
+void idle(Game& game, const ChunkedLevel& level, int frames) {
+    for (int f = 0; f < frames; ++f) {
+        streamChunks(game, level);
+        game.handleInput({ false, false, false });
+        game.update(1.0f / 60.0f);
+        game.drainEvents();
+    }
+}
+
+// Instant retry as GameCanvas does it: a snapshot taken as soon as the level has loaded must
+// restore however many chunks have streamed since. Returns the first failed check, or nullptr.
+const char* checkChunkedRetry(size_t platforms) {
+    const ChunkedLevel level = makeChunkedLevel(platforms, 20.0f);
+    Game game;
+    game.loadLevelBinary(level.manifest.data(), level.manifest.size());
+    std::vector<uint8_t> start, landed, again;
+    game.saveState(start);
+
+    idle(game, level, 120); // streams the first chunks, lands on the goal
+    game.saveState(landed);
+    SnapshotHeader header;
+    readSnapshotHeader(landed.data(), landed.size(), header);
+    if (header.goalCount != 1) return "the player did not land on the goal";
+    idle(game, level, 60);
+    if (!game.restoreState(landed.data(), landed.size())) return "snapshot on a triggered goal refused";
+    game.saveState(again);
+    if (again != landed) return "goal snapshot state differs after restore";
+
+    if (!game.restoreState(start.data(), start.size())) return "snapshot taken before streaming refused";
+    game.saveState(again);
+    if (again != start) return "start state differs after restore";
+    idle(game, level, 120);
+    game.saveState(again);
+    if (again != landed) return "replaying from the start state diverged";
+    return nullptr;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t platforms = 10000;
+    std::vector<size_t> entityCounts = { 1, 100, 1000, 10000 };
+    int iterations = 2000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--platforms") == 0) platforms = std::max<size_t>(1, std::strtoul(argv[i + 1], nullptr, 10));
+        else if (std::strcmp(argv[i], "--entities") == 0) entityCounts = parseSizes(argv[i + 1], 1);
+        else if (std::strcmp(argv[i], "--iterations") == 0) iterations = std::max(1, std::atoi(argv[i + 1]));
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    std::vector<uint8_t> level;
+    writeLevelBinary(makeLevel(platforms), level);
+    if (const char* failure = checkChunkedRetry(platforms)) {
+        std::fprintf(stderr, "chunked level retry failed: %s\n", failure);
+        return 1;
+    }
+    std::printf("%zu platforms (not part of the snapshot), %d iterations\n", platforms, iterations);
+    std::printf("%10s %10s %10s %12s %12s %10s %12s\n", "entities", "particles", "bytes", "save ns", "restore ns", "GB/s", "reload ns");
+    for (uint32_t entities : entityCounts) {
+        if (const char* failure = checkRoundTrip(level, entities)) {
+            std::fprintf(stderr, "snapshot round trip failed with %u entities: %s\n", entities, failure);
+            return 1;
+        }
+
+        Game game;
+        loadGame(game, level, entities);
+        play(game, 0, WarmupFrames);
+        std::vector<uint8_t> snapshot;
+        game.saveState(snapshot);
+
+        const uint64_t allocationsBefore = heapAllocationCount();
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; ++i) game.saveState(snapshot);
+        auto saved = Clock::now();
+        bool restored = true;
+        for (int i = 0; i < iterations; ++i) restored &= game.restoreState(snapshot.data(), snapshot.size());
+        auto done = Clock::now();
+        if (!restored || heapAllocationCount() != allocationsBefore) {
+            std::fprintf(stderr, "%u entities: %s\n", entities, restored ? "saving or restoring allocated" : "restore refused");
+            return 1;
+        }
+
+        // What restarting cost before: reloading the level (which drops the spawned entities).
+        const int reloads = std::max(1, iterations / 100);
+        auto reloadStart = Clock::now();
+        for (int i = 0; i < reloads; ++i) game.loadLevelBinary(level.data(), level.size());
+        const double reloadNs = std::chrono::duration<double, std::nano>(Clock::now() - reloadStart).count() / reloads;
+
+        const double saveNs = std::chrono::duration<double, std::nano>(saved - start).count() / iterations;
+        const double restoreNs = std::chrono::duration<double, std::nano>(done - saved).count() / iterations;
+        SnapshotHeader header;
+        readSnapshotHeader(snapshot.data(), snapshot.size(), header);
+        std::printf("%10u %10u %10zu %12.0f %12.0f %10.2f %12.0f\n", entities, header.particleCount, snapshot.size(), saveNs,
+                    restoreNs, snapshot.size() / saveNs, reloadNs);
+    }
+    return 0;
+}
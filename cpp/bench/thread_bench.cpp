@@ -0,0 +1,132 @@
+// Threading benchmark: runs the two parallel workloads -- entity physics and particle
+// integration -- at 1, 2, 4 and 8 threads and reports the speedup over one thread. Every
+// multi-threaded run must end in exactly the state of the single-threaded one (game state
+// checksum, particle arrays); the bench fails otherwise. Speedups are bounded by the cores
+// the machine actually has.
+//
+// Usage: thread_bench [--threads N,N,...] [--bodies N] [--particles N] [--frames F]
+// Build: cmake -S cpp -B build && cmake --build build --target thread_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "BenchLevel.hpp"
+#include "Game.hpp"
+#include "ParticleSystem.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct GameResult {
+    double nsPerFrame;
+    uint32_t checksum;
+};
+
+GameResult runGame(const std::vector<uint8_t>& level, float levelWidth, size_t bodies, int threads, int frames) {
+    Game game;
+    game.setThreadCount(threads);
+    game.loadLevelBinary(level.data(), level.size());
+    game.setSeed(1);
+    uint32_t seed = 777u;
+    for (size_t i = 0; i < bodies; ++i) {
+        const float x = -9.0f + (nextRandom(seed) % 10000) / 10000.0f * (levelWidth - 2.0f);
+        game.spawnEntity(EntityKind::Enemy, { x, 5.0f + (nextRandom(seed) % 400) / 100.0f }, { 0.5f, 0.5f });
+    }
+    const InputState right{ false, true, false };
+    const InputState rightJump{ false, true, true };
+    auto start = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        game.handleInput(f % 44 < 40 ? right : rightJump);
+        game.update(1.0f / 60.0f);
+        game.drainEvents();
+    }
+    const double totalNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return { totalNs / frames, game.getStateChecksum() };
+}
+
+struct ParticleResult {
+    double nsPerFrame;
+    std::vector<float> state; // live positions, rotations and lives at the end
+};
+
+// Steady state of `live` particles: each frame spawns what the previous one lost.
+ParticleResult runParticles(size_t live, int threads, int frames) {
+    JobSystem jobs;
+    jobs.setThreadCount(threads);
+    ParticleSystem pool(live);
+    uint32_t seed = 99u;
+    auto refill = [&]() {
+        while (pool.size() < live) {
+            const float life = 0.5f + (nextRandom(seed) % 1000) / 1000.0f;
+            pool.emit({ 0.0f, 0.0f }, { (nextRandom(seed) % 200 - 100) / 50.0f, (nextRandom(seed) % 200) / 50.0f },
+                      life, 0.05f, (nextRandom(seed) % 100 - 50) * 0.1f);
+        }
+    };
+    refill();
+    auto start = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        pool.update(1.0f / 60.0f, &jobs);
+        refill();
+    }
+    const double totalNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    const ParticleArrays& a = pool.arrays();
+    ParticleResult result{ totalNs / frames, {} };
+    result.state.insert(result.state.end(), a.positionX.begin(), a.positionX.begin() + pool.size());
+    result.state.insert(result.state.end(), a.positionY.begin(), a.positionY.begin() + pool.size());
+    result.state.insert(result.state.end(), a.rotation.begin(), a.rotation.begin() + pool.size());
+    result.state.insert(result.state.end(), a.life.begin(), a.life.begin() + pool.size());
+    return result;
+}
+
+bool sameBits(const std::vector<float>& a, const std::vector<float>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<size_t> threadCounts = { 1, 2, 4, 8 };
+    size_t bodies = 10000;
+    size_t particles = 100000;
+    int frames = 600;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--threads") == 0) threadCounts = parseSizes(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--bodies") == 0) bodies = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--particles") == 0) particles = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--frames") == 0) frames = std::max(1, std::atoi(argv[i + 1]));
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    const size_t platforms = 10000;
+    std::vector<uint8_t> level;
+    writeLevelBinary(makeLevel(platforms), level);
+    const float levelWidth = static_cast<float>((platforms + 7) / 8) * 20.0f;
+
+    const GameResult gameBaseline = runGame(level, levelWidth, bodies, 1, frames);
+    const ParticleResult particleBaseline = runParticles(particles, 1, frames);
+    std::printf("%8s %16s %10s %16s %10s\n", "threads", "entities ns/f", "speedup", "particles ns/f", "speedup");
+    for (size_t threads : threadCounts) {
+        const GameResult g = threads == 1 ? gameBaseline : runGame(level, levelWidth, bodies, static_cast<int>(threads), frames);
+        if (g.checksum != gameBaseline.checksum) {
+            std::fprintf(stderr, "game state differs from the single-threaded run at %zu threads\n", threads);
+            return 1;
+        }
+        const ParticleResult p = threads == 1 ? particleBaseline : runParticles(particles, static_cast<int>(threads), frames);
+        if (!sameBits(p.state, particleBaseline.state)) {
+            std::fprintf(stderr, "particles differ from the single-threaded run at %zu threads\n", threads);
+            return 1;
+        }
+        std::printf("%8zu %16.0f %9.2fx %16.0f %9.2fx\n", threads, g.nsPerFrame, gameBaseline.nsPerFrame / g.nsPerFrame,
+                    p.nsPerFrame, particleBaseline.nsPerFrame / p.nsPerFrame);
+    }
+    return 0;
+}
@@ -0,0 +1,12 @@
+#ifndef ALLOCATION_HOOK_HPP
+#define ALLOCATION_HOOK_HPP
+
+#include <cstdint>
+
+// Heap accounting for hosts that want it: linking AllocationHook.cpp into a target replaces
+// the global operator new/delete there, counting every allocation and reporting its bytes to
+// profileAllocation. The replacements live in their own translation unit so the compiler
+// never inlines a free() against an operator new call it cannot see into.
+uint64_t heapAllocationCount(); // global allocations so far
+
+#endif // ALLOCATION_HOOK_HPP
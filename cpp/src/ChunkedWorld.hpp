@@ -0,0 +1,168 @@
+#ifndef CHUNKED_WORLD_HPP
+#define CHUNKED_WORLD_HPP
+
+#include <map>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include "Types.hpp"
+#include "LevelFormat.hpp"
+
+// Streams a level split into fixed-width x-chunks. Chunk k covers [k * width, (k + 1) * width);
+// a platform is listed in every chunk its x-extent touches, and is assembled from the first
+// resident one only. Chunks within `radius` of the focus chunk are wanted; resident chunks
+// further than radius + 1 away are evicted, so walking back and forth across a boundary
+// does not thrash.
+class ChunkedWorld {
+public:
+    // Starts a new chunked level. chunkWidth <= 0 turns chunking off. Bounds, if given,
+    // limit the chunks that are ever requested.
+    void reset(float width, bool bounded, float minX, float maxX) {
+        chunks.clear();
+        requested.clear();
+        goalOwners.clear();
+        chunkWidth = width;
+        hasLimits = bounded;
+        if (bounded && width > 0.0f) {
+            firstChunk = chunkOf(minX);
+            lastChunk = chunkOf(maxX);
+        }
+        focusChunk = INT32_MIN;
+    }
+
+    bool active() const { return chunkWidth > 0.0f; }
+    float width() const { return chunkWidth; }
+    void setRadius(int chunkRadius) {
+        radius = std::max(0, chunkRadius);
+        focusChunk = INT32_MIN; // recompute the window on the next focus()
+    }
+
+    int32_t chunkOf(float x) const {
+        float c = std::floor(x / chunkWidth);
+        c = std::min(std::max(c, -1073741824.0f), 1073741824.0f);
+        return static_cast<int32_t>(c);
+    }
+
+    // Moves the wanted window to the chunk holding x. Returns true if chunks were evicted,
+    // in which case the assembled level must be rebuilt. goalTriggered is the assembled
+    // goal state, saved into the chunks before any of them go away.
+    bool focus(float x, const std::vector<bool>& goalTriggered) {
+        const int32_t center = chunkOf(x);
+        if (center == focusChunk) return false;
+        focusChunk = center;
+        storeGoalState(goalTriggered);
+        const int64_t keepLo = static_cast<int64_t>(center) - radius - 1;
+        const int64_t keepHi = static_cast<int64_t>(center) + radius + 1;
+        bool evicted = false;
+        for (auto it = chunks.begin(); it != chunks.end();) {
+            if (it->first < keepLo || it->first > keepHi) {
+                it = chunks.erase(it);
+                evicted = true;
+                goalOwners.clear(); // stale until the next assemble()
+            } else {
+                ++it;
+            }
+        }
+        refreshRequests();
+        return evicted;
+    }
+
+    // Wanted chunks that are not resident yet, nearest first.
+    const std::vector<int32_t>& requestedChunks() const { return requested; }
+
+    // Makes a chunk resident. Returns false (and drops the data) if it is no longer wanted
+    // or already resident.
+    bool load(int32_t chunk, LevelData&& data) {
+        if (!wanted(chunk) || chunks.count(chunk)) return false;
+        Chunk& stored = chunks[chunk];
+        stored.platforms = std::move(data.platforms);
+        stored.goals = std::move(data.goals);
+        stored.goalTriggered.assign(stored.goals.size(), false);
+        refreshRequests();
+        return true;
+    }
+
+    // Copies goal completion back into the resident chunks, so it survives reassembly.
+    void storeGoalState(const std::vector<bool>& goalTriggered) {
+        for (size_t i = 0; i < goalOwners.size() && i < goalTriggered.size(); ++i) {
+            goalOwners[i].first->goalTriggered[goalOwners[i].second] = goalTriggered[i];
+        }
+    }
+
+    // Concatenates the resident chunks, in ascending chunk order, into the flat lists the
+    // broadphase and renderer use.
+    void assemble(std::vector<Platform>& platforms, std::vector<Platform>& goals, std::vector<bool>& goalTriggered) {
+        platforms.clear();
+        goals.clear();
+        goalTriggered.clear();
+        goalOwners.clear();
+        for (auto& entry : chunks) {
+            Chunk& chunk = entry.second;
+            for (const Platform& platform : chunk.platforms) {
+                if (ownedBy(entry.first, platform)) platforms.push_back(platform);
+            }
+            for (size_t i = 0; i < chunk.goals.size(); ++i) {
+                if (!ownedBy(entry.first, chunk.goals[i])) continue;
+                goals.push_back(chunk.goals[i]);
+                goalTriggered.push_back(chunk.goalTriggered[i]);
+                goalOwners.push_back({ &chunk, i });
+            }
+        }
+    }
+
+    size_t residentCount() const { return chunks.size(); }
+
+    // False while the chunk holding x is wanted but has not arrived yet.
+    bool ready(float x) const {
+        const int32_t chunk = chunkOf(x);
+        return chunks.count(chunk) || !wanted(chunk);
+    }
+
+private:
+    struct Chunk {
+        std::vector<Platform> platforms;
+        std::vector<Platform> goals;
+        std::vector<bool> goalTriggered;
+    };
+
+    bool wanted(int64_t chunk) const {
+        if (focusChunk == INT32_MIN) return false;
+        if (hasLimits && (chunk < firstChunk || chunk > lastChunk)) return false;
+        return std::abs(chunk - focusChunk) <= radius;
+    }
+
+    // A record listed in several resident chunks is kept only by the lowest of them.
+    bool ownedBy(int32_t chunk, const Platform& record) const {
+        const int32_t first = std::max(chunkOf(record.position.x - record.size.x / 2.0f), chunks.begin()->first);
+        for (int32_t k = first; k < chunk; ++k) {
+            if (chunks.count(k)) return false;
+        }
+        return true;
+    }
+
+    void refreshRequests() {
+        requested.clear();
+        if (focusChunk == INT32_MIN) return;
+        auto consider = [this](int64_t chunk) {
+            if (wanted(chunk) && !chunks.count(static_cast<int32_t>(chunk))) requested.push_back(static_cast<int32_t>(chunk));
+        };
+        consider(focusChunk);
+        for (int d = 1; d <= radius; ++d) {
+            consider(static_cast<int64_t>(focusChunk) - d);
+            consider(static_cast<int64_t>(focusChunk) + d);
+        }
+    }
+
+    float chunkWidth = 0.0f;
+    int radius = 1;
+    bool hasLimits = false;
+    int32_t firstChunk = 0;
+    int32_t lastChunk = 0;
+    int32_t focusChunk = INT32_MIN;
+    std::map<int32_t, Chunk> chunks;
+    std::vector<int32_t> requested;
+    std::vector<std::pair<Chunk*, size_t>> goalOwners;
+};
+
+#endif // CHUNKED_WORLD_HPP
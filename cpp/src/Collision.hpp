@@ -0,0 +1,127 @@
+#ifndef COLLISION_HPP
+#define COLLISION_HPP
+
+#include <vector>
+#include <cmath>
+#include "Types.hpp"
+#include "PlatformGrid.hpp"
+
+// Axis-aligned overlap test on centre/size boxes. Touching edges do not count.
+inline bool checkCollision(const Vec2& posA, const Vec2& sizeA, const Vec2& posB, const Vec2& sizeB) {
+    bool collisionX = (posA.x - sizeA.x / 2.0f < posB.x + sizeB.x / 2.0f) &&
+                      (posA.x + sizeA.x / 2.0f > posB.x - sizeB.x / 2.0f);
+    bool collisionY = (posA.y - sizeA.y / 2.0f < posB.y + sizeB.y / 2.0f) &&
+                      (posA.y + sizeA.y / 2.0f > posB.y - sizeB.y / 2.0f);
+    return collisionX && collisionY;
+}
+
+// The thin box groundCheckDistance below the body's feet.
+inline Aabb groundProbeBox(const Vec2& position, const Vec2& size, float groundCheckDistance) {
+    Vec2 groundCheckPos = {position.x, position.y - size.y / 2.0f - groundCheckDistance};
+    Vec2 groundCheckSize = {size.x * 0.9f, 0.1f };
+    return PlatformGrid::boxOf(groundCheckPos, groundCheckSize);
+}
+
+// True if the ground probe box touches any platform. It stays on the grid: the cells bound
+// the candidates by the probe's own footprint, and even with PlatformSweep bucketed by width
+// a probe there is a binary search per width class (broadphase_bench times the two).
+inline bool probeGround(const PlatformGrid& grid, GridScratch& scratch,
+                        const Vec2& position, const Vec2& size, float groundCheckDistance) {
+    Aabb probe = groundProbeBox(position, size, groundCheckDistance);
+    grid.query(probe, scratch);
+    return grid.anyOverlap(probe, scratch);
+}
+
+// Continuous check for a move along one axis from prevPosition (the other coordinate is the
+// same at both ends). resolveX/resolveY only see where the body ended up: a fast body can skip
+// clean over a thin platform, or end up past its centre line and get pushed out of the far
+// side. This finds the first platform whose near face the body crossed (the earliest time of
+// impact; ties go to the lower index) and, in either of those cases, stops the body against
+// that face and zeroes its velocity on the axis. Anything else is left to the discrete
+// resolve exactly as before, and moves too short to reach past a platform's centre line skip
+// the query. Returns true if the body was stopped.
+inline bool sweepAxis(const std::vector<Platform>& platforms, const PlatformGrid& grid, GridScratch& scratch,
+                      float Vec2::*axis, Vec2& position, Vec2& velocity, const Vec2& size, const Vec2& prevPosition) {
+    const float travel = position.*axis - prevPosition.*axis;
+    // Crossing a centre line from outside takes at least the two half-extents (less a little
+    // slack for rounding).
+    if (!(std::abs(travel) >= 0.49f * (size.*axis + grid.thinnestExtent().*axis))) return false;
+    float Vec2::*other = axis == &Vec2::x ? &Vec2::y : &Vec2::x;
+    const Aabb start = PlatformGrid::boxOf(prevPosition, size);
+    const Aabb end = PlatformGrid::boxOf(position, size);
+    grid.query(PlatformGrid::merge(start, end), scratch);
+    float firstDistance = INFINITY;
+    uint32_t first = 0;
+    for (uint32_t i : scratch.candidates) {
+        const Aabb p = grid.boundsOf(i);
+        if (!(start.min.*other < p.max.*other && start.max.*other > p.min.*other)) continue;
+        float distance;
+        if (travel < 0.0f) {
+            if (start.min.*axis < p.max.*axis || end.min.*axis >= p.max.*axis) continue;
+            distance = start.min.*axis - p.max.*axis;
+        } else {
+            if (start.max.*axis > p.min.*axis || end.max.*axis <= p.min.*axis) continue;
+            distance = p.min.*axis - start.max.*axis;
+        }
+        if (distance < firstDistance) {
+            firstDistance = distance;
+            first = i;
+        }
+    }
+    if (firstDistance == INFINITY) return false;
+    // resolveX/resolveY push the body out on the side its centre is on.
+    const float centre = platforms[first].position.*axis;
+    const bool pushedOutFarSide = travel < 0.0f ? !(position.*axis - centre > 0.0f) : position.*axis - centre > 0.0f;
+    const Aabb p = grid.boundsOf(first);
+    const bool passedThrough = travel < 0.0f ? end.max.*axis <= p.min.*axis : end.min.*axis >= p.max.*axis;
+    if (!pushedOutFarSide && !passedThrough) return false;
+    position.*axis = travel < 0.0f ? p.max.*axis + size.*axis / 2.0f : p.min.*axis - size.*axis / 2.0f;
+    velocity.*axis = 0.0f;
+    return true;
+}
+
+// Pushes the body out of any platform it overlaps after a vertical move from prevPosition.
+inline void resolveY(const std::vector<Platform>& platforms, const PlatformGrid& grid, GridScratch& scratch,
+                     Vec2& position, Vec2& velocity, const Vec2& size, const Vec2& prevPosition) {
+    Aabb swept = PlatformGrid::merge(PlatformGrid::boxOf(prevPosition, size), PlatformGrid::boxOf(position, size));
+    grid.walkInOrder(swept, [&] { return PlatformGrid::boxOf(position, size); }, [&](uint32_t i) {
+        // Only called for platforms the body currently overlaps.
+        const Platform& platform = platforms[i];
+        float playerHalfY = size.y / 2.0f;
+        float platformHalfY = platform.size.y / 2.0f;
+        float deltaY = position.y - platform.position.y;
+        float penetrationY = (playerHalfY + platformHalfY) - std::abs(deltaY);
+        // Rounding can leave the body a hair inside the face, which resolveX would then
+        // take for a wall and push the body out sideways; step it clear by whole ulps.
+        if (deltaY > 0) { // Landing on top of a platform
+            position.y += penetrationY;
+            const float top = platform.position.y + platformHalfY;
+            while (position.y - playerHalfY < top) position.y = std::nextafter(position.y, INFINITY);
+            if (velocity.y < 0) velocity.y = 0;
+        } else { // Hitting a platform from below
+            position.y -= penetrationY;
+            const float bottom = platform.position.y - platformHalfY;
+            while (position.y + playerHalfY > bottom) position.y = std::nextafter(position.y, -INFINITY);
+            if (velocity.y > 0) velocity.y = 0;
+        }
+    }, scratch);
+}
+
+// Pushes the body out of any platform it overlaps after a horizontal move from prevPosition.
+inline void resolveX(const std::vector<Platform>& platforms, const PlatformGrid& grid, GridScratch& scratch,
+                     Vec2& position, Vec2& velocity, const Vec2& size, const Vec2& prevPosition) {
+    Aabb swept = PlatformGrid::merge(PlatformGrid::boxOf(prevPosition, size), PlatformGrid::boxOf(position, size));
+    grid.walkInOrder(swept, [&] { return PlatformGrid::boxOf(position, size); }, [&](uint32_t i) {
+        // Only called for platforms the body currently overlaps.
+        const Platform& platform = platforms[i];
+        float playerHalfX = size.x / 2.0f;
+        float platformHalfX = platform.size.x / 2.0f;
+        float deltaX = position.x - platform.position.x;
+        float penetrationX = (playerHalfX + platformHalfX) - std::abs(deltaX);
+        if (deltaX > 0) position.x += penetrationX;
+        else position.x -= penetrationX;
+        velocity.x = 0;
+    }, scratch);
+}
+
+#endif // COLLISION_HPP
@@ -0,0 +1,287 @@
+#ifndef ENTITIES_HPP
+#define ENTITIES_HPP
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "Types.hpp"
+#include "Collision.hpp"
+
+enum class EntityKind : uint32_t {
+    Player = 0,      // always entity 0, driven by handleInput
+    Enemy = 1,       // dynamic: walks at its patrol speed and turns around when blocked
+    Collectible = 2, // static pickup, removed when the player touches it
+    MovingPlatform = 3, // kinematic: runs back and forth along its path, carrying what stands on it
+};
+
+constexpr uint32_t PlayerEntity = 0;
+
+// Heap addresses of the entity component arrays, for JS to wrap as typed-array views.
+// Each array has `count` live entries; they move whenever entities are added or removed.
+struct EntityView {
+    uint32_t count;
+    uintptr_t positionX;
+    uintptr_t positionY;
+    uintptr_t sizeX;
+    uintptr_t sizeY;
+    uintptr_t kind;  // uint32 per entity (EntityKind)
+    uintptr_t state; // uint32 per entity (PlayerState)
+};
+
+// Structure-of-arrays entity storage: one contiguous array per component, indexed by
+// entity slot. Removing an entity moves the last one into its slot; the player in slot 0
+// is never moved.
+class EntityStore {
+public:
+    // transform / velocity / AABB size
+    std::vector<float> positionX, positionY;
+    std::vector<float> velocityX, velocityY;
+    std::vector<float> sizeX, sizeY;
+    // ground contact this step and the previous one
+    std::vector<uint8_t> grounded, wasGrounded;
+    // 1 = gravity and platform collision apply
+    std::vector<uint8_t> dynamic;
+    std::vector<uint32_t> kind;
+    std::vector<uint32_t> state; // PlayerState, doubles as the animation state
+    std::vector<float> patrolSpeed; // enemies: signed walking speed; moving platforms: speed, > 0 heading for pathEnd
+    std::vector<float> pathStartX, pathStartY, pathEndX, pathEndY; // moving platforms
+
+    uint32_t create(EntityKind entityKind, const Vec2& position, const Vec2& size, bool isDynamic, float speed = 0.0f) {
+        positionX.push_back(position.x);
+        positionY.push_back(position.y);
+        velocityX.push_back(speed); // a patroller starts out walking
+        velocityY.push_back(0.0f);
+        sizeX.push_back(size.x);
+        sizeY.push_back(size.y);
+        grounded.push_back(0);
+        wasGrounded.push_back(0);
+        dynamic.push_back(isDynamic ? 1 : 0);
+        kind.push_back(static_cast<uint32_t>(entityKind));
+        state.push_back(static_cast<uint32_t>(PlayerState::Idle));
+        patrolSpeed.push_back(speed);
+        pathStartX.push_back(position.x);
+        pathStartY.push_back(position.y);
+        pathEndX.push_back(position.x);
+        pathEndY.push_back(position.y);
+        return count++;
+    }
+
+    void setPath(uint32_t i, const Vec2& start, const Vec2& end) {
+        pathStartX[i] = start.x;
+        pathStartY[i] = start.y;
+        pathEndX[i] = end.x;
+        pathEndY[i] = end.y;
+    }
+
+    void remove(uint32_t index) {
+        if (index == PlayerEntity || index >= count) return;
+        const uint32_t last = count - 1;
+        forEachComponent([index, last](auto& field) {
+            field[index] = field[last];
+            field.pop_back();
+        });
+        --count;
+    }
+
+    // Drops every entity except the player.
+    void truncateToPlayer() {
+        const uint32_t keep = std::min<uint32_t>(count, 1);
+        forEachComponent([keep](auto& field) { field.resize(keep); });
+        count = keep;
+    }
+
+    void reserve(size_t n) {
+        forEachComponent([n](auto& field) { field.reserve(n); });
+    }
+
+    // Sets the entity count; new slots are zeroed. Used by snapshot restore, which then
+    // overwrites every component.
+    void resize(uint32_t n) {
+        forEachComponent([n](auto& field) { field.resize(n); });
+        count = n;
+    }
+
+    Vec2 position(uint32_t i) const { return { positionX[i], positionY[i] }; }
+    Vec2 velocity(uint32_t i) const { return { velocityX[i], velocityY[i] }; }
+    Vec2 size(uint32_t i) const { return { sizeX[i], sizeY[i] }; }
+    void setPosition(uint32_t i, const Vec2& p) { positionX[i] = p.x; positionY[i] = p.y; }
+    void setVelocity(uint32_t i, const Vec2& v) { velocityX[i] = v.x; velocityY[i] = v.y; }
+
+    uint32_t size() const { return count; }
+
+    EntityView view() const {
+        auto address = [](const auto& field) { return reinterpret_cast<uintptr_t>(field.data()); };
+        return { count, address(positionX), address(positionY), address(sizeX), address(sizeY), address(kind), address(state) };
+    }
+
+    // Calls fn(array) for every component array, always in the same order.
+    template <typename Fn>
+    void forEachComponent(Fn fn) {
+        fn(positionX); fn(positionY);
+        fn(velocityX); fn(velocityY);
+        fn(sizeX); fn(sizeY);
+        fn(grounded); fn(wasGrounded);
+        fn(dynamic);
+        fn(kind);
+        fn(state);
+        fn(patrolSpeed);
+        fn(pathStartX); fn(pathStartY); fn(pathEndX); fn(pathEndY);
+    }
+    template <typename Fn>
+    void forEachComponent(Fn fn) const { const_cast<EntityStore*>(this)->forEachComponent([&fn](const auto& field) { fn(field); }); }
+
+private:
+
+    uint32_t count = 0;
+};
+
+// The moving platforms for one step, as platforms: where they were when the step began,
+// where they are now, and a grid over each. The movers move first, on their own; bodies then
+// collide with them after the static platforms, as if they were static for the rest of the step.
+struct MoverLayer {
+    std::vector<uint32_t> entity;    // entity slot per mover
+    std::vector<Platform> before;    // boxes at the start of the step
+    std::vector<Platform> after;     // boxes after this step's move
+    PlatformGrid beforeGrid;
+    PlatformGrid afterGrid;
+    Aabb beforeBounds{ { 0.0f, 0.0f }, { 0.0f, 0.0f } }; // around all of `before`, for a quick reject
+    Aabb afterBounds{ { 0.0f, 0.0f }, { 0.0f, 0.0f } };
+
+    bool empty() const { return entity.empty(); }
+    static bool touches(const Aabb& a, const Aabb& b) {
+        return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y;
+    }
+};
+
+// Moves moving platform i one step along its path, turning around at either end. A zero
+// step (update(0) in variable-step mode) moves nothing, so the mover is at rest for it.
+inline void advanceMover(EntityStore& e, uint32_t i, float deltaTime) {
+    if (!(deltaTime > 0.0f)) {
+        e.setVelocity(i, { 0.0f, 0.0f });
+        return;
+    }
+    const bool outbound = e.patrolSpeed[i] > 0.0f;
+    const Vec2 target = outbound ? Vec2{ e.pathEndX[i], e.pathEndY[i] } : Vec2{ e.pathStartX[i], e.pathStartY[i] };
+    const Vec2 position = e.position(i);
+    const Vec2 toTarget = { target.x - position.x, target.y - position.y };
+    const float distance = std::sqrt(toTarget.x * toTarget.x + toTarget.y * toTarget.y);
+    const float travel = std::abs(e.patrolSpeed[i]) * deltaTime;
+    if (travel >= distance) {
+        e.setPosition(i, target);
+        e.patrolSpeed[i] = -e.patrolSpeed[i];
+    } else {
+        e.setPosition(i, { position.x + toTarget.x / distance * travel, position.y + toTarget.y / distance * travel });
+    }
+    const Vec2 moved = e.position(i);
+    e.setVelocity(i, { (moved.x - position.x) / deltaTime, (moved.y - position.y) / deltaTime });
+}
+
+// Batch physics systems over the dynamic entities in [begin, end). Bodies collide with the
+// platforms and the moving platforms, never with each other, so running each phase across all
+// bodies gives exactly the per-body results of running the phases body by body -- and disjoint
+// ranges can run on different threads, each with its own GridScratch.
+
+// A body that was standing on a moving platform moves with it: the first mover (in slot
+// order) under its feet at the start of the step carries it by that mover's displacement.
+inline void carrySystem(EntityStore& e, const MoverLayer& movers, GridScratch& scratch, float checkDistance,
+                        size_t begin, size_t end) {
+    if (movers.empty()) return;
+    for (size_t i = begin; i < end; ++i) {
+        if (!e.dynamic[i] || !e.grounded[i]) continue;
+        const Vec2 position = e.position(i);
+        const Aabb probe = groundProbeBox(position, e.size(i), checkDistance);
+        if (!MoverLayer::touches(probe, movers.beforeBounds)) continue;
+        movers.beforeGrid.query(probe, scratch);
+        for (uint32_t k : scratch.candidates) {
+            if (!movers.beforeGrid.overlapMask(probe, &k, 1)) continue;
+            const Platform& from = movers.before[k];
+            const Vec2& to = movers.after[k].position;
+            e.setPosition(i, { position.x + (to.x - from.position.x), position.y + (to.y - from.position.y) });
+            break;
+        }
+    }
+}
+
+inline void groundProbeSystem(EntityStore& e, const PlatformGrid& grid, const MoverLayer& movers, GridScratch& scratch,
+                              float checkDistance, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        if (!e.dynamic[i]) continue;
+        e.wasGrounded[i] = e.grounded[i];
+        bool onGround = probeGround(grid, scratch, e.position(i), e.size(i), checkDistance);
+        if (!onGround && !movers.empty() &&
+            MoverLayer::touches(groundProbeBox(e.position(i), e.size(i), checkDistance), movers.afterBounds)) {
+            onGround = probeGround(movers.afterGrid, scratch, e.position(i), e.size(i), checkDistance);
+        }
+        e.grounded[i] = onGround ? 1 : 0;
+    }
+}
+
+inline void gravitySystem(EntityStore& e, float gravity, float deltaTime, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        if (!e.dynamic[i]) continue;
+        if (!e.grounded[i]) {
+            e.velocityY[i] += gravity * deltaTime;
+        } else {
+            e.velocityY[i] = std::max(0.0f, e.velocityY[i]);
+        }
+    }
+}
+
+// Moves along y, then x, resolving each axis against the platforms in between. The swept
+// check catches platforms a fast body would otherwise skip over within one step. Moving
+// platforms, where they ended up this step, are resolved after the static ones on each axis.
+inline void moveAndCollideSystem(EntityStore& e, const std::vector<Platform>& platforms, const PlatformGrid& grid,
+                                 const MoverLayer& movers, GridScratch& scratch, float deltaTime, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        if (!e.dynamic[i]) continue;
+        Vec2 position = e.position(i);
+        Vec2 velocity = e.velocity(i);
+        const Vec2 size = e.size(i);
+        auto nearMovers = [&movers, &size](const Vec2& from, const Vec2& to) {
+            if (movers.empty()) return false;
+            return MoverLayer::touches(PlatformGrid::merge(PlatformGrid::boxOf(from, size), PlatformGrid::boxOf(to, size)), movers.afterBounds);
+        };
+        Vec2 prevPosition = position;
+        position.y += velocity.y * deltaTime;
+        sweepAxis(platforms, grid, scratch, &Vec2::y, position, velocity, size, prevPosition);
+        resolveY(platforms, grid, scratch, position, velocity, size, prevPosition);
+        if (nearMovers(prevPosition, position)) {
+            sweepAxis(movers.after, movers.afterGrid, scratch, &Vec2::y, position, velocity, size, prevPosition);
+            resolveY(movers.after, movers.afterGrid, scratch, position, velocity, size, prevPosition);
+        }
+        prevPosition = position;
+        position.x += velocity.x * deltaTime;
+        sweepAxis(platforms, grid, scratch, &Vec2::x, position, velocity, size, prevPosition);
+        resolveX(platforms, grid, scratch, position, velocity, size, prevPosition);
+        if (nearMovers(prevPosition, position)) {
+            sweepAxis(movers.after, movers.afterGrid, scratch, &Vec2::x, position, velocity, size, prevPosition);
+            resolveX(movers.after, movers.afterGrid, scratch, position, velocity, size, prevPosition);
+        }
+        e.setPosition(i, position);
+        e.setVelocity(i, velocity);
+    }
+}
+
+// Enemies walk at their patrol speed and turn around when a wall stopped them (resolveX
+// zeroes the velocity it was given last step).
+inline void patrolSystem(EntityStore& e, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        if (e.kind[i] != static_cast<uint32_t>(EntityKind::Enemy)) continue;
+        if (e.velocityX[i] == 0.0f) e.patrolSpeed[i] = -e.patrolSpeed[i];
+        e.velocityX[i] = e.patrolSpeed[i];
+    }
+}
+
+// Animation state for the non-player bodies, using the player's rules.
+inline void entityStateSystem(EntityStore& e, size_t begin, size_t end) {
+    for (size_t i = std::max<size_t>(begin, 1); i < end; ++i) {
+        if (!e.dynamic[i]) continue;
+        PlayerState s;
+        if (!e.grounded[i]) s = e.velocityY[i] > 0 ? PlayerState::Jump : PlayerState::Fall;
+        else if (std::abs(e.velocityX[i]) > 0.01f) s = PlayerState::Run;
+        else s = PlayerState::Idle;
+        e.state[i] = static_cast<uint32_t>(s);
+    }
+}
+
+#endif // ENTITIES_HPP
@@ -1,21 +1,18 @@
 #include "Game.hpp"
+#include "Collision.hpp"
+#include <utility>
+#include <cstring>
 #include <cmath>
 #include <algorithm>
-#include <emscripten/val.h>
-#include <cstdlib> // For rand()
 
 
 Game::Game() {
-    playerPosition = {0.0f, -1.5f};
-    playerVelocity = {0.0f, 0.0f};
-    playerSize = {0.5f, 0.8f};
+    entities.create(EntityKind::Player, {0.0f, -1.5f}, {0.5f, 0.8f}, true); // PlayerEntity
     cameraPosition = {0.0f, 0.0f};
-    playerAnimation = {"idle", 0, false};
-    isGrounded = false;
-    wasGrounded = false; // Initialize previous grounded state
+    previousPlayerPosition = getPlayerPosition();
+    previousCameraPosition = cameraPosition;
+    playerAnimation = { static_cast<uint32_t>(AnimationId::Idle), 0, false };
     canJump = true;
-    soundCallback = emscripten::val::null(); // Initialize callback to null
-    levelCompleteCallback = emscripten::val::null();
 
     // Default ground/platforms (fallback)
     platforms.push_back({ {-12.25f, -2.0f}, {110.0f, 0.2f} });
@@ -90,51 +87,72 @@ Game::Game() {
 
     // Goal platform - elevated finish line
     platforms.push_back({ {93.0f, 1.5f}, {3.0f, 0.5f} });
+
+    rebuildBroadphase();
 }
 
-    // Vertical climb section
-    platforms.push_back({ {46.0f, 2.0f}, {2.0f, 0.2f} });
-    platforms.push_back({ {47.5f, 3.0f}, {1.5f, 0.2f} });
-    platforms.push_back({ {46.0f, 4.0f}, {1.5f, 0.2f} });
-    platforms.push_back({ {47.5f, 5.0f}, {1.5f, 0.2f} });
+void Game::setSoundHandler(SoundHandler handler) {
+    soundHandler = std::move(handler);
+}
 
-    // Long jumps
-    platforms.push_back({ {49.5f, 5.5f}, {1.5f, 0.2f} });
-    platforms.push_back({ {52.0f, 6.0f}, {2.0f, 0.2f} });
+void Game::setLevelCompleteHandler(LevelCompleteHandler handler) {
+    levelCompleteHandler = std::move(handler);
+}
 
-    // Final high platform
-    platforms.push_back({ {55.0f, 7.0f}, {2.0f, 0.2f} });
+void Game::emitSound(SoundId sound) {
+    const Vec2 feet = playerFeet();
+    events.push(EventType::Sound, static_cast<uint32_t>(sound), feet.x, feet.y);
 }
 
-void Game::setSoundCallback(emscripten::val callback) {
-    soundCallback = callback;
+EventView Game::drainEvents() {
+    return events.drain();
 }
 
-void Game::setLevelCompleteCallback(emscripten::val callback) {
-    levelCompleteCallback = callback;
+// Compatibility layer for hosts that registered callbacks: forwards the queued events once
+// per update(), after the simulation rather than from inside it.
+void Game::dispatchCallbacks() {
+    if (!soundHandler && !levelCompleteHandler) return;
+    ProfileScope scope(profiler, ProfilePhase::Callbacks);
+    events.drain([this](const GameEvent& event) {
+        if (event.type == EventType::Sound && soundHandler) {
+            soundHandler(static_cast<SoundId>(event.code));
+            profiler.count(ProfileCounter::CallbacksFired);
+        } else if (event.type == EventType::GoalReached && levelCompleteHandler) {
+            levelCompleteHandler();
+            profiler.count(ProfileCounter::CallbacksFired);
+        }
+    });
 }
 
-void Game::playSound(const std::string& soundName) {
-    if (!soundCallback.isNull()) {
-        soundCallback(soundName);
+#ifdef __EMSCRIPTEN__
+void Game::setSoundCallback(emscripten::val callback) {
+    if (callback.isNull() || callback.isUndefined()) {
+        soundHandler = nullptr;
+        return;
     }
+    // The JS callback still takes names; convert them once here rather than on every sound.
+    std::vector<emscripten::val> names;
+    for (uint32_t i = 0; i < SoundCount; ++i) names.push_back(emscripten::val(soundName(static_cast<SoundId>(i))));
+    soundHandler = [callback, names](SoundId sound) { callback(names[static_cast<uint32_t>(sound)]); };
+}
+
+void Game::setLevelCompleteCallback(emscripten::val callback) {
+    if (callback.isNull() || callback.isUndefined()) levelCompleteHandler = nullptr;
+    else levelCompleteHandler = [callback]() { callback(); };
 }
 
 void Game::loadLevel(const emscripten::val& level) {
     // Expecting an object like: { spawn: {x,y}, platforms: [{position:{x,y}, size:{x,y}}, ...], bounds: {min:{x,y}, max:{x,y}}, goals: [...] }
+    // Every field read is a call into JS; large levels should use loadLevelBinary instead.
     if (level.isNull() || level.isUndefined()) return;
-    platforms.clear();
-    goals.clear();
-    goalTriggered.clear();
-    hasLevelBounds = false;
+    LevelData data;
 
     // spawn
     if (level.hasOwnProperty("spawn")) {
         emscripten::val spawn = level["spawn"];
         if (!spawn.isNull() && !spawn.isUndefined() && spawn.hasOwnProperty("x") && spawn.hasOwnProperty("y")) {
-            playerPosition.x = spawn["x"].as<float>();
-            playerPosition.y = spawn["y"].as<float>();
-            playerVelocity = {0.0f, 0.0f};
+            data.spawn = { spawn["x"].as<float>(), spawn["y"].as<float>() };
+            data.hasSpawn = true;
         }
     }
 
@@ -142,6 +160,7 @@ void Game::loadLevel(const emscripten::val& level) {
     if (level.hasOwnProperty("platforms")) {
         emscripten::val jsPlatforms = level["platforms"];
         const unsigned length = jsPlatforms["length"].as<unsigned>();
+        data.platforms.reserve(length);
         for (unsigned i = 0; i < length; ++i) {
             emscripten::val jsPlatform = jsPlatforms[i];
             if (jsPlatform.hasOwnProperty("position") && jsPlatform.hasOwnProperty("size")) {
@@ -151,7 +170,7 @@ void Game::loadLevel(const emscripten::val& level) {
                     jsSize.hasOwnProperty("x") && jsSize.hasOwnProperty("y")) {
                     Vec2 position = { jsPosition["x"].as<float>(), jsPosition["y"].as<float>() };
                     Vec2 size = { jsSize["x"].as<float>(), jsSize["y"].as<float>() };
-                    platforms.push_back({ position, size });
+                    data.platforms.push_back({ position, size });
                 }
             }
         }
@@ -170,8 +189,7 @@ void Game::loadLevel(const emscripten::val& level) {
                     jsSize.hasOwnProperty("x") && jsSize.hasOwnProperty("y")) {
                     Vec2 position = { jsPosition["x"].as<float>(), jsPosition["y"].as<float>() };
                     Vec2 size = { jsSize["x"].as<float>(), jsSize["y"].as<float>() };
-                    goals.push_back({ position, size });
-                    goalTriggered.push_back(false);
+                    data.goals.push_back({ position, size });
                 }
             }
         }
@@ -185,43 +203,176 @@ void Game::loadLevel(const emscripten::val& level) {
             emscripten::val max = bounds["max"];
             if (min.hasOwnProperty("x") && min.hasOwnProperty("y") &&
                 max.hasOwnProperty("x") && max.hasOwnProperty("y")) {
-                levelMin = { min["x"].as<float>(), min["y"].as<float>() };
-                levelMax = { max["x"].as<float>(), max["y"].as<float>() };
-                hasLevelBounds = true;
+                data.boundsMin = { min["x"].as<float>(), min["y"].as<float>() };
+                data.boundsMax = { max["x"].as<float>(), max["y"].as<float>() };
+                data.hasBounds = true;
             }
         }
     }
+    applyLevel(std::move(data));
+}
+#endif // __EMSCRIPTEN__
+
+bool Game::loadLevelBinary(const uint8_t* data, size_t length) {
+    LevelData level;
+    if (!parseLevelBinary(data, length, level)) return false;
+    applyLevel(std::move(level));
+    return true;
+}
+
+bool Game::loadLevelBinaryFromHeap(uintptr_t ptr, uint32_t length) {
+    return loadLevelBinary(reinterpret_cast<const uint8_t*>(ptr), length);
+}
+
+void Game::loadGeneratedLevel(uint32_t seed, uint32_t platformCount, float density) {
+    applyLevel(LevelGenerator::generate({ seed, platformCount, density }, getMovementLimits()));
+}
+
+MovementLimits Game::getMovementLimits() const {
+    return { tuning.gravity, tuning.moveSpeed, tuning.jumpStrength, getPlayerSize() };
+}
+
+void Game::applyLevel(LevelData&& level) {
+    levelId = levelIdentity(level);
+    platforms = std::move(level.platforms);
+    goals = std::move(level.goals);
+    goalTriggered.assign(goals.size(), false);
+    entities.truncateToPlayer(); // enemies and pickups belong to the old level
+    moversDirty = true;
+    if (level.hasSpawn) {
+        entities.setPosition(PlayerEntity, level.spawn);
+        entities.setVelocity(PlayerEntity, {0.0f, 0.0f});
+    }
+    hasLevelBounds = level.hasBounds;
+    if (level.hasBounds) {
+        levelMin = level.boundsMin;
+        levelMax = level.boundsMax;
+    }
+    chunkedWorld.reset(level.chunkWidth, level.hasBounds, level.boundsMin.x, level.boundsMax.x);
+    rebuildBroadphase();
     // Set camera to player on load
-    cameraPosition.x = playerPosition.x;
+    cameraPosition.x = entities.positionX[PlayerEntity];
+    if (chunkedWorld.active()) chunkedWorld.focus(cameraPosition.x, goalTriggered);
+    // Don't interpolate across the teleport to the spawn point
+    previousPlayerPosition = getPlayerPosition();
+    previousCameraPosition = cameraPosition;
+    accumulator = 0.0f;
 }
 
+void Game::setChunkRadius(int radius) {
+    chunkedWorld.setRadius(radius);
+    if (chunkedWorld.active() && chunkedWorld.focus(cameraPosition.x, goalTriggered)) refreshChunks();
+}
+
+uint32_t Game::getRequestedChunkCount() const {
+    return static_cast<uint32_t>(chunkedWorld.requestedChunks().size());
+}
+
+int32_t Game::getRequestedChunk(uint32_t index) const {
+    return chunkedWorld.requestedChunks()[index];
+}
+
+bool Game::loadChunkBinary(int32_t chunk, const uint8_t* data, size_t length) {
+    if (!chunkedWorld.active()) return false;
+    LevelData level;
+    if (length != 0 && !parseLevelBinary(data, length, level)) return false;
+    if (!chunkedWorld.load(chunk, std::move(level))) return false;
+    refreshChunks();
+    return true;
+}
+
+bool Game::loadChunkBinaryFromHeap(int32_t chunk, uintptr_t ptr, uint32_t length) {
+    return loadChunkBinary(chunk, reinterpret_cast<const uint8_t*>(ptr), length);
+}
+
+void Game::refreshChunks() {
+    chunkedWorld.storeGoalState(goalTriggered);
+    chunkedWorld.assemble(platforms, goals, goalTriggered);
+    rebuildBroadphase();
+}
+
+void Game::rebuildBroadphase() {
+    ++platformRevision;
+    platformGrid.build(platforms);
+    platformSweep.build(platforms);
+    goalGrid.build(goals);
+    staticSprites.build(platforms, platformRevision);
+    staticRanges.reserve(staticSprites.classCount()); // so finding them per frame never allocates
+}
+
+
+void Game::setPhysicsProfile(PhysicsProfile profile) {
+    switch (profile) {
+        case PhysicsProfile::Standard: tuning = tuningOf<StandardPhysics>(); break;
+        case PhysicsProfile::LowFx: tuning = tuningOf<LowFxPhysics>(); break;
+        case PhysicsProfile::HighFx: tuning = tuningOf<HighFxPhysics>(); break;
+        case PhysicsProfile::Custom: break;
+        default: return;
+    }
+    physicsProfile = profile;
+}
+
+PhysicsProfile Game::getPhysicsProfile() const { return physicsProfile; }
+
+void Game::setPhysicsTuning(const PhysicsTuning& values) {
+    tuning = values;
+    // Keep a bad value from hanging the step: the animation loop needs a positive frame
+    // time. Burst sizes are clamped where the bursts are emitted.
+    if (!(tuning.frameDuration > 0.0f)) tuning.frameDuration = StandardPhysics::frameDuration;
+    physicsProfile = PhysicsProfile::Custom;
+}
+
+PhysicsTuning Game::getPhysicsTuning() const { return tuning; }
+
+// Calls fn with the active profile's constants, so each profile gets its own instantiation
+// of the code fn runs; Custom hands over the run-time values instead.
+template <typename Fn>
+void Game::withTuning(Fn fn) {
+    switch (physicsProfile) {
+        case PhysicsProfile::Standard: fn(StandardPhysics{}); break;
+        case PhysicsProfile::LowFx: fn(LowFxPhysics{}); break;
+        case PhysicsProfile::HighFx: fn(HighFxPhysics{}); break;
+        case PhysicsProfile::Custom: fn(tuning); break;
+    }
+}
 
 void Game::handleInput(const InputState& input) {
+    if (replaying) return; // the replay supplies the input
+    frameInput = input;
+    frameHasInput = true;
+    applyInput(input);
+}
+
+void Game::applyInput(const InputState& input) {
+    withTuning([this, &input](const auto& t) { applyInputWith(t, input); });
+}
+
+template <typename Tuning>
+void Game::applyInputWith(const Tuning& t, const InputState& input) {
+    float& velocityX = entities.velocityX[PlayerEntity];
     if (input.left) {
-        playerVelocity.x = -moveSpeed;
+        velocityX = -t.moveSpeed;
         playerAnimation.facingLeft = true;
     } else if (input.right) {
-        playerVelocity.x = moveSpeed;
+        velocityX = t.moveSpeed;
         playerAnimation.facingLeft = false;
     } else {
-        playerVelocity.x = 0;
+        velocityX = 0;
     }
 
     // Jump logic
-    if (input.jump && isGrounded && canJump) {
-        playerVelocity.y = jumpStrength;
-        isGrounded = false;
+    if (input.jump && entities.grounded[PlayerEntity] && canJump) {
+        entities.velocityY[PlayerEntity] = t.jumpStrength;
+        entities.grounded[PlayerEntity] = 0;
         canJump = false;
         currentPlayerState = PlayerState::Jump;
-        playSound("jump");
+        emitSound(SoundId::Jump);
         
-        // Emit jump particles
-        for (int i = 0; i < 10; ++i) {
-            float angle = (rand() % 100 / 100.0f) * 3.14159f;
-            float speed = 1.0f + (rand() % 100 / 100.0f) * 2.0f;
-            Vec2 vel = { std::cos(angle) * speed * 0.5f, std::sin(angle) * speed * 0.5f };
-            Vec2 pos = { playerPosition.x, playerPosition.y - playerSize.y / 2.0f };
-            particleSystem.emit(pos, vel, 0.5f, 0.1f, (rand() % 100 - 50) * 0.1f);
+        // Jump dust: a half-circle fan upwards
+        if (t.jumpParticles != 0) {
+            // origin, base velocity, spread scale, angle, speed, spin, lifetime, size, seed, count
+            bursts.emit({ playerFeet(), { 0.0f, 0.0f }, { 0.5f, 0.5f }, 0.0f, 3.14159f, 1.0f, 2.0f, -5.0f, 10.0f,
+                          0.5f, 0.1f, rng.next(), t.jumpParticles, 0.0 });
         }
     }
     if (!input.jump) {
@@ -230,98 +381,474 @@ void Game::handleInput(const InputState& input) {
 }
 
 
+void Game::setFixedTimestep(float tickRate, int maxSubstepsPerUpdate) {
+    fixedDeltaTime = tickRate > 0.0f ? 1.0f / tickRate : 0.0f;
+    maxSubsteps = std::max(1, maxSubstepsPerUpdate);
+    accumulator = 0.0f;
+    interpolationAlpha = 1.0f;
+}
+
+
 void Game::update(float deltaTime) {
-    particleSystem.update(deltaTime);
-
-    wasGrounded = isGrounded; // Store the state from the previous frame
-    isGrounded = false;
-    float groundCheckDistance = 0.05f;
-    Vec2 groundCheckPos = {playerPosition.x, playerPosition.y - playerSize.y / 2.0f - groundCheckDistance};
-    Vec2 groundCheckSize = {playerSize.x * 0.9f, 0.1f };
-    for (const auto& platform : platforms) {
-        if (checkCollision(groundCheckPos, groundCheckSize, platform.position, platform.size)) {
-            isGrounded = true;
-            break;
+    ProfileFrame profileFrame(profiler);
+    const size_t emittedBefore = particlesEmitted();
+    const size_t killedBefore = particlesKilled();
+    const bool playing = replaying;
+    if (playing) {
+        ReplayFrame frame;
+        if (!replayReader.next(frame)) { // corrupt frame data
+            replaying = false;
+            return;
         }
+        if (frame.hasInput) applyInput(frame.input);
+        deltaTime = frame.deltaTime;
+    } else if (recording) {
+        recorder.addFrame({ frameInput, frameHasInput, deltaTime });
+    }
+    frameHasInput = false;
+    advance(deltaTime);
+    if (playing || recording) trackSession(playing);
+    dispatchCallbacks();
+    countFrame(emittedBefore, killedBefore);
+}
+
+size_t Game::particlesEmitted() const { return particleSystem.emittedCount() + bursts.emittedCount(); }
+
+size_t Game::particlesKilled() const { return particleSystem.killedCount() + bursts.killedCount(); }
+
+void Game::countFrame(size_t particlesEmittedBefore, size_t particlesKilledBefore) {
+#if PLATFORMER_PROFILE
+    profiler.set(ProfileCounter::ParticlesAlive, particleSystem.size() + bursts.particleCount());
+    profiler.count(ProfileCounter::ParticlesEmitted, particlesEmitted() - particlesEmittedBefore);
+    profiler.count(ProfileCounter::ParticlesKilled, particlesKilled() - particlesKilledBefore);
+    for (GridScratch& scratch : workerScratch) {
+        profiler.count(ProfileCounter::CollisionTests, scratch.tests);
+        scratch.tests = 0;
+    }
+    profiler.count(ProfileCounter::CollisionTests, gridScratch.tests);
+    gridScratch.tests = 0;
+#else
+    (void)particlesEmittedBefore;
+    (void)particlesKilledBefore;
+#endif
+}
+
+void Game::trackSession(bool playing) {
+    ++sessionFrame;
+    if (recording && recorder.interval() != 0 && sessionFrame % recorder.interval() == 0) {
+        recorder.addChecksum(getStateChecksum());
     }
-    if (isGrounded && !wasGrounded) {
-        playSound("land");
-        // Emit land particles
-        for (int i = 0; i < 10; ++i) {
-            float angle = (rand() % 100 / 100.0f) * 3.14159f; // 0 to PI
-            float speed = 1.0f + (rand() % 100 / 100.0f) * 2.0f;
-            Vec2 vel = { std::cos(angle) * speed, std::abs(std::sin(angle) * speed * 0.5f) }; 
-            Vec2 pos = { playerPosition.x, playerPosition.y - playerSize.y / 2.0f };
-            particleSystem.emit(pos, vel, 0.3f, 0.08f, (rand() % 100 - 50) * 0.1f);
+    if (playing) {
+        uint32_t expected;
+        if (replayDivergence < 0 && replayReader.expectedChecksum(sessionFrame, expected) && expected != getStateChecksum()) {
+            replayDivergence = static_cast<int32_t>(sessionFrame);
         }
+        if (replayReader.position() == replayReader.totalFrames()) replaying = false;
     }
-    if (!isGrounded) {
-        playerVelocity.y += gravity * deltaTime;
-    } else {
-        playerVelocity.y = std::max(0.0f, playerVelocity.y);
-    }
-    playerPosition.y += playerVelocity.y * deltaTime;
-    for (const auto& platform : platforms) {
-        if (checkCollision(playerPosition, playerSize, platform.position, platform.size)) {
-            float playerHalfY = playerSize.y / 2.0f;
-            float platformHalfY = platform.size.y / 2.0f;
-            float deltaY = playerPosition.y - platform.position.y;
-            float penetrationY = (playerHalfY + platformHalfY) - std::abs(deltaY);
-            if (deltaY > 0) { // Landing on top of a platform
-                playerPosition.y += penetrationY;
-                if (playerVelocity.y < 0) playerVelocity.y = 0;
-            } else { // Hitting a platform from below
-                playerPosition.y -= penetrationY;
-                if (playerVelocity.y > 0) playerVelocity.y = 0;
+}
+
+void Game::setSeed(uint32_t seed) {
+    rng.reseed(seed);
+}
+
+void Game::startRecording(uint32_t seed, uint32_t checksumInterval) {
+    replaying = false;
+    rng.reseed(seed);
+    recorder.begin(seed, checksumInterval);
+    recording = true;
+    sessionFrame = 0;
+    frameHasInput = false;
+}
+
+void Game::stopRecording() {
+    if (!recording) return;
+    recorder.encode(recordingBuffer);
+    recording = false;
+}
+
+const std::vector<uint8_t>& Game::getRecording() const { return recordingBuffer; }
+
+uintptr_t Game::getRecordingData() const { return reinterpret_cast<uintptr_t>(recordingBuffer.data()); }
+
+uint32_t Game::getRecordingSize() const { return static_cast<uint32_t>(recordingBuffer.size()); }
+
+bool Game::startReplay(const uint8_t* data, size_t length) {
+    replayBuffer.assign(data, data + length);
+    if (!replayReader.open(replayBuffer.data(), replayBuffer.size())) {
+        replaying = false;
+        return false;
+    }
+    recording = false;
+    rng.reseed(replayReader.rngSeed());
+    sessionFrame = 0;
+    replayDivergence = -1;
+    replaying = replayReader.totalFrames() > 0;
+    return true;
+}
+
+bool Game::startReplayFromHeap(uintptr_t ptr, uint32_t length) {
+    return startReplay(reinterpret_cast<const uint8_t*>(ptr), length);
+}
+
+int32_t Game::runReplay() {
+    while (replaying) update(0.0f); // deltaTime comes from the recording
+    return replayDivergence;
+}
+
+bool Game::isReplaying() const { return replaying; }
+
+int32_t Game::getReplayDivergence() const { return replayDivergence; }
+
+// FNV-1a over everything that feeds back into the simulation. Float fields are hashed by
+// bit pattern, so any divergence at all shows up.
+uint32_t Game::getStateChecksum() const {
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 16777619u;
+        }
+    };
+    const uint32_t entityCount = entities.size();
+    mix(&entityCount, sizeof(entityCount));
+    mix(entities.positionX.data(), entityCount * sizeof(float));
+    mix(entities.positionY.data(), entityCount * sizeof(float));
+    mix(entities.velocityX.data(), entityCount * sizeof(float));
+    mix(entities.velocityY.data(), entityCount * sizeof(float));
+    mix(entities.grounded.data(), entityCount);
+    mix(entities.wasGrounded.data(), entityCount);
+    mix(&cameraPosition, sizeof(Vec2));
+    mix(&accumulator, sizeof(float));
+    const uint8_t flags[2] = { canJump, static_cast<uint8_t>(currentPlayerState) };
+    mix(flags, sizeof(flags));
+    const uint64_t rngState = rng.getState();
+    mix(&rngState, sizeof(rngState));
+    const uint32_t particleCount = getParticleCount();
+    mix(&particleCount, sizeof(particleCount));
+    const ParticleArrays& particles = particleSystem.arrays();
+    mix(particles.positionX.data(), particleCount * sizeof(float));
+    mix(particles.positionY.data(), particleCount * sizeof(float));
+    mix(particles.life.data(), particleCount * sizeof(float));
+    const double burstClock = bursts.clock();
+    mix(&burstClock, sizeof(burstClock));
+    const uint32_t burstCount = getBurstCount();
+    mix(&burstCount, sizeof(burstCount));
+    mix(bursts.data().data(), burstCount * sizeof(ParticleBurst));
+    for (bool triggered : goalTriggered) {
+        const uint8_t b = triggered;
+        mix(&b, 1);
+    }
+    return hash;
+}
+
+// Bytes of the fixed scalar block: three Vec2s, three floats, the burst clock, the RNG state,
+// the animation id and frame, and four flag bytes.
+constexpr size_t SnapshotScalarSize = 3 * sizeof(Vec2) + 3 * sizeof(float) + sizeof(double) + sizeof(uint64_t) +
+                                      2 * sizeof(uint32_t) + 4;
+
+size_t Game::stateSize(uint32_t entityCount, uint32_t particleCount, uint32_t burstCount, uint32_t goalCount) const {
+    size_t entityBytes = 0;
+    entities.forEachComponent([&entityBytes](const auto& field) { entityBytes += sizeof(field[0]); });
+    size_t particleBytes = 0;
+    particleSystem.forEachField([&particleBytes](const std::vector<float>&) { particleBytes += sizeof(float); });
+    return SnapshotHeaderSize + SnapshotScalarSize + entityCount * entityBytes + particleCount * particleBytes +
+           burstCount * sizeof(ParticleBurst) + goalCount * sizeof(Vec2);
+}
+
+void Game::saveState(std::vector<uint8_t>& out) const {
+    const uint32_t entityCount = entities.size();
+    const uint32_t particleCount = getParticleCount();
+    const uint32_t burstCount = getBurstCount();
+    const uint32_t goalCount = static_cast<uint32_t>(std::count(goalTriggered.begin(), goalTriggered.end(), true));
+    const size_t length = stateSize(entityCount, particleCount, burstCount, goalCount);
+    if (out.capacity() < length) out.reserve(length);
+    SnapshotWriter writer(out);
+    writer.bytes("WPSS", 4);
+    writer.value(SnapshotHeader{ SnapshotFormatVersion, static_cast<uint32_t>(length), levelId, goalCount,
+                                 entityCount, particleCount, burstCount });
+
+    writer.value(cameraPosition);
+    writer.value(previousPlayerPosition);
+    writer.value(previousCameraPosition);
+    writer.value(accumulator);
+    writer.value(interpolationAlpha);
+    writer.value(animationTimer);
+    writer.value(bursts.clock());
+    writer.value(rng.getState());
+    writer.value(playerAnimation.animation);
+    writer.value(playerAnimation.currentFrame);
+    const uint8_t flags[4] = { canJump, playerAnimation.facingLeft, static_cast<uint8_t>(currentPlayerState),
+                               static_cast<uint8_t>(reportedPlayerState) };
+    writer.bytes(flags, sizeof(flags));
+
+    entities.forEachComponent([&writer, entityCount](const auto& field) { writer.array(field, entityCount); });
+    particleSystem.forEachField([&writer, particleCount](const std::vector<float>& field) { writer.array(field, particleCount); });
+    writer.array(bursts.data(), burstCount);
+    for (size_t i = 0; i < goals.size(); ++i) {
+        if (goalTriggered[i]) writer.value(goals[i].position);
+    }
+}
+
+bool Game::restoreState(const uint8_t* data, size_t length) {
+    SnapshotHeader header;
+    if (!readSnapshotHeader(data, length, header)) return false;
+    if (header.level != levelId || header.entityCount == 0 || header.particleCount > particleSystem.capacity() ||
+        stateSize(header.entityCount, header.particleCount, header.burstCount, header.goalCount) != length) {
+        return false;
+    }
+    // Everything is read and checked before anything is changed, so a refused snapshot
+    // leaves the game as it was.
+    SnapshotReader reader(data + SnapshotHeaderSize);
+    Vec2 camera, previousPlayer, previousCamera;
+    float accumulated, alpha, animationTime;
+    double burstClock;
+    uint64_t rngState;
+    AnimationState animation = playerAnimation;
+    uint8_t flags[4];
+    reader.value(camera);
+    reader.value(previousPlayer);
+    reader.value(previousCamera);
+    reader.value(accumulated);
+    reader.value(alpha);
+    reader.value(animationTime);
+    reader.value(burstClock);
+    reader.value(rngState);
+    reader.value(animation.animation);
+    reader.value(animation.currentFrame);
+    reader.bytes(flags, sizeof(flags));
+    const uint32_t lastState = static_cast<uint32_t>(PlayerState::Fall);
+    if (animation.animation >= AnimationCount || flags[2] > lastState || flags[3] > lastState) {
+        return false;
+    }
+
+    // Entity kinds and states are enums too: find their arrays by walking the components in
+    // place. The player, and only the player, is entity 0.
+    const uint32_t entityCount = header.entityCount;
+    const uint8_t* entityData = reader.skip(0);
+    bool entitiesValid = true;
+    entities.forEachComponent([&](const auto& field) {
+        const uint8_t* array = reader.skip(entityCount * sizeof(field[0]));
+        const void* component = &field;
+        if (component != &entities.kind && component != &entities.state) return;
+        for (uint32_t i = 0; i < entityCount; ++i) {
+            uint32_t value;
+            std::memcpy(&value, array + i * sizeof(uint32_t), sizeof(value));
+            if (component == &entities.state) {
+                entitiesValid &= value <= lastState;
+            } else {
+                const bool player = value == static_cast<uint32_t>(EntityKind::Player);
+                entitiesValid &= value <= static_cast<uint32_t>(EntityKind::MovingPlatform) && player == (i == PlayerEntity);
             }
         }
+    });
+    if (!entitiesValid) return false;
+    const uint32_t particleCount = header.particleCount;
+    const uint8_t* particleData = reader.skip(0);
+    particleSystem.forEachField([&reader, particleCount](const std::vector<float>&) { reader.skip(particleCount * sizeof(float)); });
+    if (!bursts.restore(burstClock, reader.skip(header.burstCount * sizeof(ParticleBurst)), header.burstCount)) return false;
+
+    cameraPosition = camera;
+    previousPlayerPosition = previousPlayer;
+    previousCameraPosition = previousCamera;
+    accumulator = accumulated;
+    interpolationAlpha = alpha;
+    animationTimer = animationTime;
+    rng.setState(rngState);
+    playerAnimation = animation;
+    canJump = flags[0] != 0;
+    playerAnimation.facingLeft = flags[1] != 0;
+    currentPlayerState = static_cast<PlayerState>(flags[2]);
+    reportedPlayerState = static_cast<PlayerState>(flags[3]);
+
+    SnapshotReader components(entityData);
+    entities.resize(entityCount);
+    moversDirty = true;
+    entities.forEachComponent([&components, entityCount](auto& field) { components.array(field, entityCount); });
+    SnapshotReader fields(particleData);
+    particleSystem.resize(particleCount);
+    particleSystem.forEachField([&fields, particleCount](std::vector<float>& field) { fields.array(field, particleCount); });
+
+    // Goals are saved by position: on a chunked level the assembled list depends on which
+    // chunks are resident, so indices from the time of saving may not line up.
+    std::fill(goalTriggered.begin(), goalTriggered.end(), false);
+    for (uint32_t k = 0; k < header.goalCount; ++k) {
+        Vec2 position;
+        reader.value(position);
+        for (size_t i = 0; i < goals.size(); ++i) {
+            if (std::memcmp(&goals[i].position, &position, sizeof(Vec2)) == 0) goalTriggered[i] = true;
+        }
+    }
+
+    events.clear(); // they belong to the timeline being abandoned
+    // Stream around the restored camera: evict what it no longer needs and request what it
+    // does. step() holds the simulation until the player's chunk is resident again.
+    if (chunkedWorld.active() && chunkedWorld.focus(cameraPosition.x, goalTriggered)) refreshChunks();
+    return true;
+}
+
+uint32_t Game::saveStateToBuffer() {
+    saveState(stateBuffer);
+    return static_cast<uint32_t>(stateBuffer.size());
+}
+
+uintptr_t Game::getStateData() const { return reinterpret_cast<uintptr_t>(stateBuffer.data()); }
+
+bool Game::restoreStateFromHeap(uintptr_t ptr, uint32_t length) {
+    return restoreState(reinterpret_cast<const uint8_t*>(ptr), length);
+}
+
+void Game::advance(float deltaTime) {
+    if (fixedDeltaTime <= 0.0f) {
+        previousPlayerPosition = getPlayerPosition();
+        previousCameraPosition = cameraPosition;
+        step(deltaTime);
+        interpolationAlpha = 1.0f;
+        return;
+    }
+
+    accumulator += deltaTime;
+    int substeps = 0;
+    while (accumulator >= fixedDeltaTime && substeps < maxSubsteps) {
+        previousPlayerPosition = getPlayerPosition();
+        previousCameraPosition = cameraPosition;
+        step(fixedDeltaTime);
+        accumulator -= fixedDeltaTime;
+        ++substeps;
+    }
+    // Out of catch-up budget (e.g. after a long stall): drop the backlog instead of
+    // trying to simulate it next frame, which would only make that frame slower too.
+    if (accumulator >= fixedDeltaTime) {
+        accumulator = std::fmod(accumulator, fixedDeltaTime);
+    }
+    interpolationAlpha = accumulator / fixedDeltaTime;
+}
+
+
+void Game::collectPickups(const Vec2& playerPosition, const Vec2& playerSize) {
+    // Walk backwards so a swap-remove only moves entities that were already checked.
+    for (uint32_t i = entities.size(); i-- > 1;) {
+        if (entities.kind[i] != static_cast<uint32_t>(EntityKind::Collectible)) continue;
+        const Vec2 position = entities.position(i);
+        if (!checkCollision(playerPosition, playerSize, position, entities.size(i))) continue;
+        events.push(EventType::Collected, i, position.x, position.y);
+        entities.remove(i);
+        moversDirty = true;
+    }
+}
+
+void Game::moveMovers(float deltaTime) {
+    if (moversDirty) {
+        movers.entity.clear();
+        for (uint32_t i = 1; i < entities.size(); ++i) {
+            if (entities.kind[i] == static_cast<uint32_t>(EntityKind::MovingPlatform)) movers.entity.push_back(i);
+        }
+        movers.before.resize(movers.entity.size());
+        movers.after.resize(movers.entity.size());
+        moversDirty = false;
+    }
+    if (movers.empty()) return;
+    for (size_t k = 0; k < movers.entity.size(); ++k) {
+        const uint32_t i = movers.entity[k];
+        movers.before[k] = { entities.position(i), entities.size(i) };
+        advanceMover(entities, i, deltaTime);
+        movers.after[k] = { entities.position(i), entities.size(i) };
+    }
+    auto boundsOf = [](const std::vector<Platform>& boxes) {
+        Aabb bounds = PlatformGrid::boxOf(boxes[0].position, boxes[0].size);
+        for (const Platform& p : boxes) bounds = PlatformGrid::merge(bounds, PlatformGrid::boxOf(p.position, p.size));
+        return bounds;
+    };
+    movers.beforeBounds = boundsOf(movers.before);
+    movers.afterBounds = boundsOf(movers.after);
+    movers.beforeGrid.build(movers.before);
+    movers.afterGrid.build(movers.after);
+}
+
+
+void Game::step(float deltaTime) {
+    withTuning([this, deltaTime](const auto& t) { stepWith(t, deltaTime); });
+}
+
+template <typename Tuning>
+void Game::stepWith(const Tuning& t, float deltaTime) {
+    profiler.count(ProfileCounter::Steps);
+    {
+        ProfileScope scope(profiler, ProfilePhase::Particles);
+        particleSystem.update(deltaTime, &jobs);
+        bursts.update(deltaTime);
+    }
+    // Don't let the player fall through ground that hasn't streamed in yet.
+    if (chunkedWorld.active() && !chunkedWorld.ready(entities.positionX[PlayerEntity])) return;
+
+    const uint32_t bodies = entities.size();
+    {
+        ProfileScope scope(profiler, ProfilePhase::GroundProbe);
+        moveMovers(deltaTime);
+        const float checkDistance = t.groundCheckDistance;
+        jobs.parallelFor(bodies, EntityGrain, [this, checkDistance](size_t begin, size_t end, int worker) {
+            patrolSystem(entities, begin, end);
+            carrySystem(entities, movers, workerScratch[worker], checkDistance, begin, end);
+            groundProbeSystem(entities, platformGrid, movers, workerScratch[worker], checkDistance, begin, end);
+        });
     }
-    playerPosition.x += playerVelocity.x * deltaTime;
-    for (const auto& platform : platforms) {
-        if (checkCollision(playerPosition, playerSize, platform.position, platform.size)) {
-            float playerHalfX = playerSize.x / 2.0f;
-            float platformHalfX = platform.size.x / 2.0f;
-            float deltaX = playerPosition.x - platform.position.x;
-            float penetrationX = (playerHalfX + platformHalfX) - std::abs(deltaX);
-            if (deltaX > 0) playerPosition.x += penetrationX;
-            else playerPosition.x -= penetrationX;
-            playerVelocity.x = 0;
+    if (entities.grounded[PlayerEntity] && !entities.wasGrounded[PlayerEntity]) {
+        ProfileScope scope(profiler, ProfilePhase::Emission);
+        emitSound(SoundId::Land);
+        // Land dust: a flat fan, wider than it is tall
+        if (t.landParticles != 0) {
+            bursts.emit({ playerFeet(), { 0.0f, 0.0f }, { 1.0f, 0.5f }, 0.0f, 3.14159f, 1.0f, 2.0f, -5.0f, 10.0f,
+                          0.3f, 0.08f, rng.next(), t.landParticles, 0.0 });
         }
     }
+    {
+        ProfileScope scope(profiler, ProfilePhase::Movement);
+        const float gravity = t.gravity;
+        jobs.parallelFor(bodies, EntityGrain, [this, gravity, deltaTime](size_t begin, size_t end, int worker) {
+            gravitySystem(entities, gravity, deltaTime, begin, end);
+            moveAndCollideSystem(entities, platforms, platformGrid, movers, workerScratch[worker], deltaTime, begin, end);
+            entityStateSystem(entities, begin, end);
+        });
+    }
+
+    const Vec2 playerPosition = entities.position(PlayerEntity);
+    const Vec2 playerSize = entities.size(PlayerEntity);
+    const Vec2 playerVelocity = entities.velocity(PlayerEntity);
     // State Machine Update
-    if (!isGrounded) {
+    if (!entities.grounded[PlayerEntity]) {
         if (playerVelocity.y > 0) currentPlayerState = PlayerState::Jump;
         else currentPlayerState = PlayerState::Fall; // We can map Fall to Jump animation or a new one
     } else if (std::abs(playerVelocity.x) > 0.01f) {
         currentPlayerState = PlayerState::Run;
         // Emit run particles occasionally
-        if ((rand() % 100) < 10) { 
-             Vec2 vel = { -playerVelocity.x * 0.5f, 0.5f + (rand() % 100 / 100.0f) };
-             Vec2 pos = { playerPosition.x, playerPosition.y - playerSize.y / 2.0f };
-             particleSystem.emit(pos, vel, 0.2f, 0.05f, (rand() % 100 - 50) * 0.1f);
+        if (t.runParticleChance != 0 && static_cast<uint32_t>(rng.below(100)) < t.runParticleChance) {
+             ProfileScope scope(profiler, ProfilePhase::Emission);
+             // A single particle kicked back and up at 0.5 to 1.5 units/s
+             bursts.emit({ playerFeet(), { -playerVelocity.x * 0.5f, 0.5f }, { 0.0f, 1.0f }, 1.5707964f, 0.0f, 0.0f, 1.0f,
+                           -5.0f, 10.0f, 0.2f, 0.05f, rng.next(), 1, 0.0 });
         }
     } else {
         currentPlayerState = PlayerState::Idle;
     }
+    entities.state[PlayerEntity] = static_cast<uint32_t>(currentPlayerState);
 
-    // Map State to String for JS
-    std::string newStateString = "idle";
+    // Map state to animation clip
+    AnimationId animation = AnimationId::Idle;
     switch (currentPlayerState) {
-        case PlayerState::Idle: newStateString = "idle"; break;
-        case PlayerState::Run: newStateString = "run"; break;
-        case PlayerState::Jump: newStateString = "jump"; break;
-        case PlayerState::Fall: newStateString = "jump"; break; // Re-use jump for now
+        case PlayerState::Idle: animation = AnimationId::Idle; break;
+        case PlayerState::Run: animation = AnimationId::Run; break;
+        case PlayerState::Jump: animation = AnimationId::Jump; break;
+        case PlayerState::Fall: animation = AnimationId::Jump; break; // Re-use jump for now
     }
 
-    if (newStateString != playerAnimation.currentState) {
-        playerAnimation.currentState = newStateString;
+    if (static_cast<uint32_t>(animation) != playerAnimation.animation) {
+        playerAnimation.animation = static_cast<uint32_t>(animation);
         playerAnimation.currentFrame = 0;
         animationTimer = 0.0f;
     }
     animationTimer += deltaTime;
-    float frameDuration = 0.25f;
-    while (animationTimer >= frameDuration) {
-        animationTimer -= frameDuration;
+    while (animationTimer >= t.frameDuration) {
+        animationTimer -= t.frameDuration;
         playerAnimation.currentFrame = (playerAnimation.currentFrame + 1);
     }
     cameraPosition.x = playerPosition.x;
@@ -330,37 +857,154 @@ void Game::update(float deltaTime) {
         if (cameraPosition.x < levelMin.x) cameraPosition.x = levelMin.x;
         if (cameraPosition.x > levelMax.x) cameraPosition.x = levelMax.x;
     }
-
-    // check goals for completion
-    for (size_t i = 0; i < goals.size(); ++i) {
-        if (goalTriggered[i]) continue;
-        if (checkCollision(playerPosition, playerSize, goals[i].position, goals[i].size)) {
-            goalTriggered[i] = true;
-            if (!levelCompleteCallback.isNull()) {
-                levelCompleteCallback();
+    if (chunkedWorld.active() && chunkedWorld.focus(cameraPosition.x, goalTriggered)) refreshChunks();
+
+    // check pickups and goals
+    {
+        ProfileScope scope(profiler, ProfilePhase::Triggers);
+        collectPickups(playerPosition, playerSize);
+        goalGrid.query(PlatformGrid::boxOf(playerPosition, playerSize), gridScratch);
+        for (uint32_t i : gridScratch.candidates) {
+            if (goalTriggered[i]) continue;
+            if (checkCollision(playerPosition, playerSize, goals[i].position, goals[i].size)) {
+                goalTriggered[i] = true;
+                events.push(EventType::GoalReached, i, goals[i].position.x, goals[i].position.y);
             }
         }
     }
-}
-
 
-bool Game::checkCollision(const Vec2& posA, const Vec2& sizeA, const Vec2& posB, const Vec2& sizeB) {
-    bool collisionX = (posA.x - sizeA.x / 2.0f < posB.x + sizeB.x / 2.0f) &&
-                      (posA.x + sizeA.x / 2.0f > posB.x - sizeB.x / 2.0f);
-    bool collisionY = (posA.y - sizeA.y / 2.0f < posB.y + sizeB.y / 2.0f) &&
-                      (posA.y + sizeA.y / 2.0f > posB.y - sizeB.y / 2.0f);
-    return collisionX && collisionY;
+    if (currentPlayerState != reportedPlayerState) {
+        reportedPlayerState = currentPlayerState;
+        events.push(EventType::StateChanged, static_cast<uint32_t>(currentPlayerState), playerPosition.x, playerPosition.y);
+    }
 }
 
 
-Vec2 Game::getPlayerPosition() const { return playerPosition; }
+Vec2 Game::getPlayerPosition() const { return entities.position(PlayerEntity); }
 
-Vec2 Game::getPlayerSize() const { return playerSize; }
+Vec2 Game::getPlayerSize() const { return entities.size(PlayerEntity); }
+
+Vec2 Game::playerFeet() const {
+    return { entities.positionX[PlayerEntity], entities.positionY[PlayerEntity] - entities.sizeY[PlayerEntity] / 2.0f };
+}
 
 const std::vector<Platform>& Game::getPlatforms() const { return platforms; }
 
 Vec2 Game::getCameraPosition() const { return cameraPosition; }
 
+Vec2 Game::getPreviousPlayerPosition() const { return previousPlayerPosition; }
+
+Vec2 Game::getPreviousCameraPosition() const { return previousCameraPosition; }
+
+float Game::getInterpolationAlpha() const { return interpolationAlpha; }
+
 AnimationState Game::getPlayerAnimationState() const { return playerAnimation; }
 
-const std::vector<Particle>& Game::getParticles() const { return particleSystem.getParticles(); }
+
+// The platform view hands out a raw float array, so Platform must stay packed floats.
+static_assert(sizeof(Platform) == 4 * sizeof(float), "Platform must be four packed floats");
+
+BufferView Game::getPlatformView() const {
+    return { reinterpret_cast<uintptr_t>(platforms.data()), static_cast<uint32_t>(platforms.size()),
+             static_cast<uint32_t>(sizeof(Platform) / sizeof(float)) };
+}
+
+ParticleView Game::getParticleView() const {
+    const ParticleArrays& particles = particleSystem.arrays();
+    auto address = [](const std::vector<float>& field) { return reinterpret_cast<uintptr_t>(field.data()); };
+    return { getParticleCount(), static_cast<uint32_t>(particleSystem.capacity()), address(particles.positionX), address(particles.positionY), address(particles.life),
+             address(particles.maxLife), address(particles.size), address(particles.rotation) };
+}
+
+uint32_t Game::getParticleCount() const { return static_cast<uint32_t>(particleSystem.size()); }
+
+uint32_t Game::getBurstCount() const { return static_cast<uint32_t>(bursts.size()); }
+
+uint32_t Game::getBurstParticleCount() const { return static_cast<uint32_t>(bursts.particleCount()); }
+
+const BurstSystem& Game::getBursts() const { return bursts; }
+
+uint32_t Game::getPlatformRevision() const { return platformRevision; }
+
+bool Game::hasGeometryChanged(uint32_t sinceRevision) const { return sinceRevision != platformRevision; }
+
+StaticSpriteView Game::getStaticSpriteView() const { return staticSprites.view(); }
+
+uint32_t Game::findStaticSpriteRanges(float minX, float maxX) {
+    staticSprites.ranges(minX, maxX, staticRanges);
+    return static_cast<uint32_t>(staticRanges.size());
+}
+
+SpriteRange Game::getStaticSpriteRange(uint32_t index) const { return staticRanges[index]; }
+
+const StaticSpriteLayer& Game::getStaticSprites() const { return staticSprites; }
+
+RenderView Game::buildRenderBuffer(float viewWidth, float viewHeight) {
+    const Vec2 viewSize = { viewWidth, viewHeight };
+    const Aabb view = PlatformGrid::merge(PlatformGrid::boxOf(previousCameraPosition, viewSize),
+                                          PlatformGrid::boxOf(cameraPosition, viewSize));
+    renderBuffer.begin(entities.size() + particleSystem.capacity() + bursts.particleCount());
+    renderBuffer.addEntities(entities, view);
+    renderBuffer.addParticles(particleSystem, view);
+    renderBuffer.addBursts(bursts, view);
+    return renderBuffer.view();
+}
+
+const RenderBuffer& Game::getRenderBuffer() const { return renderBuffer; }
+
+RayHit Game::raycast(const Vec2& origin, const Vec2& direction, float maxDistance) const {
+    return platformSweep.raycast(origin, direction, maxDistance);
+}
+
+RayHit Game::findGroundBelow(const Vec2& point, float maxDistance) const {
+    return platformSweep.groundBelow(point, maxDistance);
+}
+
+const PlatformSweep& Game::getPlatformSweep() const { return platformSweep; }
+
+uint32_t Game::spawnEntity(EntityKind kind, const Vec2& position, const Vec2& size) {
+    switch (kind) {
+        case EntityKind::Enemy: {
+            // Alternate starting directions so a crowd spreads out.
+            const float speed = entities.size() % 2 ? tuning.enemySpeed : -tuning.enemySpeed;
+            return entities.create(kind, position, size, true, speed);
+        }
+        case EntityKind::Collectible: return entities.create(kind, position, size, false);
+        case EntityKind::MovingPlatform: return spawnMovingPlatform(position, position, size, 0.0f);
+        case EntityKind::Player: break;
+    }
+    return PlayerEntity; // there is only ever one player
+}
+
+uint32_t Game::spawnMovingPlatform(const Vec2& start, const Vec2& end, const Vec2& size, float speed) {
+    const uint32_t i = entities.create(EntityKind::MovingPlatform, start, size, false, std::abs(speed));
+    entities.setVelocity(i, { 0.0f, 0.0f });
+    entities.setPath(i, start, end);
+    moversDirty = true;
+    return i;
+}
+
+void Game::setThreadCount(int threads) {
+    jobs.setThreadCount(threads);
+    workerScratch.resize(jobs.threadCount());
+}
+
+int Game::getThreadCount() const { return jobs.threadCount(); }
+
+uint32_t Game::getEntityCount() const { return entities.size(); }
+
+EntityView Game::getEntityView() const { return entities.view(); }
+
+FrameStatsView Game::getFrameStatsView() const { return profiler.view(); }
+
+const FrameStats& Game::getFrameStats() const { return profiler.frameStats(); }
+
+const Profiler& Game::getProfiler() const { return profiler; }
+
+std::string Game::getProfileJson() const {
+    std::string json;
+    profiler.writeJson(json);
+    return json;
+}
+
+const EntityStore& Game::getEntities() const { return entities; }
@@ -1,52 +1,262 @@
+#ifndef GAME_HPP
 #define GAME_HPP
 
 #include <vector>
 #include <string>
+#include <functional>
+#ifdef __EMSCRIPTEN__
 #include <emscripten/val.h>
+#endif
 #include "Types.hpp"
 #include "ParticleSystem.hpp"
+#include "ParticleBursts.hpp"
+#include "PlatformGrid.hpp"
+#include "PlatformSweep.hpp"
+#include "LevelFormat.hpp"
+#include "LevelGenerator.hpp"
+#include "PhysicsProfile.hpp"
+#include "ChunkedWorld.hpp"
+#include "Random.hpp"
+#include "Replay.hpp"
+#include "GameEvents.hpp"
+#include "Entities.hpp"
+#include "JobSystem.hpp"
+#include "RenderBuffer.hpp"
+#include "Profiler.hpp"
+#include "Snapshot.hpp"
 
+// Optional per-event hooks, kept for compatibility with hosts that don't drain the event
+// queue. When either is set, update() forwards the queued events to them (and consumes
+// them). The JS bindings wrap JS functions in these. soundName() gives a sound's name.
+using SoundHandler = std::function<void(SoundId sound)>;
+using LevelCompleteHandler = std::function<void()>;
 
 class Game {
 public:
     Game();
     void update(float deltaTime);
     void handleInput(const InputState& input);
+    // Runs the simulation in fixed ticks of 1/tickRate seconds, at most maxSubsteps per
+    // update() call. A partial tick left over is carried to the next call, but once a call
+    // has run maxSubsteps ticks any whole ticks still owed are discarded, not caught up
+    // later: after a stall the game slows down instead of spiralling into ever longer
+    // frames. tickRate <= 0 goes back to stepping once per update() with the frame's own
+    // deltaTime.
+    void setFixedTimestep(float tickRate, int maxSubsteps);
+    // Tuning profile (PhysicsProfile.hpp). The built-in profiles run a step specialized on
+    // their constants; Custom reads getPhysicsTuning() at run time, for live tweaking.
+    // setPhysicsTuning switches to Custom. Snapshots leave both alone, as they do the timestep.
+    void setPhysicsProfile(PhysicsProfile profile); // Custom keeps the current values
+    PhysicsProfile getPhysicsProfile() const;
+    void setPhysicsTuning(const PhysicsTuning& tuning);
+    PhysicsTuning getPhysicsTuning() const;
+    void setSoundHandler(SoundHandler handler);
+    void setLevelCompleteHandler(LevelCompleteHandler handler);
+#ifdef __EMSCRIPTEN__
     void setSoundCallback(emscripten::val callback);
     void loadLevel(const emscripten::val& level);
     void setLevelCompleteCallback(emscripten::val callback); // New: set a JS callback that's invoked when a level goal is reached
+#endif
+    // Loads a level in the LevelFormat.hpp binary layout. Returns false and leaves the
+    // current level in place if the buffer is malformed.
+    bool loadLevelBinary(const uint8_t* data, size_t length);
+    // JS entry point: `ptr` is a buffer the caller copied into the WASM heap (e.g. via _malloc).
+    bool loadLevelBinaryFromHeap(uintptr_t ptr, uint32_t length);
+    // Generates and loads a level the player can get through (see LevelGenerator), for
+    // load testing without level files. density is 0..1.
+    void loadGeneratedLevel(uint32_t seed, uint32_t platformCount, float density);
+    MovementLimits getMovementLimits() const; // what the generator plans jumps around
+    // Chunked levels (a binary level with a chunk width) stream their chunks in as the camera
+    // moves: poll the requested chunks and hand each one to loadChunkBinary. The simulation
+    // holds while the chunk under the player is missing.
+    void setChunkRadius(int radius);
+    uint32_t getRequestedChunkCount() const;
+    int32_t getRequestedChunk(uint32_t index) const;
+    bool loadChunkBinary(int32_t chunk, const uint8_t* data, size_t length); // length 0 = empty chunk
+    bool loadChunkBinaryFromHeap(int32_t chunk, uintptr_t ptr, uint32_t length);
     Vec2 getPlayerPosition() const;
     Vec2 getPlayerSize() const;
     Vec2 getCameraPosition() const;
+    // State before the most recent tick; render at lerp(previous, current, getInterpolationAlpha()).
+    Vec2 getPreviousPlayerPosition() const;
+    Vec2 getPreviousCameraPosition() const;
+    float getInterpolationAlpha() const;
     const std::vector<Platform>& getPlatforms() const;
-    const std::vector<Particle>& getParticles() const;
+    BufferView getPlatformView() const;
+    ParticleView getParticleView() const;
+    uint32_t getParticleCount() const;
+    // Jump, landing and running dust are bursts (ParticleBursts.hpp), not pooled particles:
+    // they reach the host only through buildRenderBuffer, expanded for the visible ones.
+    uint32_t getBurstCount() const;
+    uint32_t getBurstParticleCount() const; // live particles across all bursts
+    const BurstSystem& getBursts() const;
+    uint32_t getPlatformRevision() const; // geometry revision: bumped whenever the platform list changes
+    bool hasGeometryChanged(uint32_t sinceRevision) const;
+    // Platform sprites, packed and sorted once per geometry revision (see StaticSpriteLayer).
+    // Upload the layer when its revision changes; per frame, draw the runs found for the view.
+    StaticSpriteView getStaticSpriteView() const;
+    uint32_t findStaticSpriteRanges(float minX, float maxX); // number of runs, read with getStaticSpriteRange
+    SpriteRange getStaticSpriteRange(uint32_t index) const;
+    const StaticSpriteLayer& getStaticSprites() const;
+    // Fills the per-frame sprite instance buffer with the entities (bar the player) and
+    // particles visible in a viewWidth x viewHeight window around the camera -- both its
+    // previous and current position, so any interpolated camera in between is covered. Call
+    // after update(); the view stays valid until the next call.
+    RenderView buildRenderBuffer(float viewWidth, float viewHeight);
+    const RenderBuffer& getRenderBuffer() const;
+
+    // Queries against the platforms (PlatformSweep), for camera logic, AI line of sight and
+    // the like. The ray's distance is in multiples of `direction`.
+    RayHit raycast(const Vec2& origin, const Vec2& direction, float maxDistance) const;
+    RayHit findGroundBelow(const Vec2& point, float maxDistance) const; // highest top at most maxDistance down
+    const PlatformSweep& getPlatformSweep() const;
+
+    // Entities share the player's physics (gravity, ground probe, platform collision) and run
+    // through it in batches. The player is entity 0; enemies patrol, collectibles sit still
+    // until the player touches them. Moving platforms are solid to every body and carry what
+    // stands on them; spawnEntity gives one that stays put. Loading a level removes every
+    // entity but the player.
+    uint32_t spawnEntity(EntityKind kind, const Vec2& position, const Vec2& size);
+    // A platform that starts at `start` and runs to `end` and back at `speed` units/s.
+    uint32_t spawnMovingPlatform(const Vec2& start, const Vec2& end, const Vec2& size, float speed);
+    uint32_t getEntityCount() const;
+    EntityView getEntityView() const; // valid until the next spawn or update
+    const EntityStore& getEntities() const;
+
+    // Splits particle integration and entity physics across `threads` threads (including the
+    // caller). Every thread count produces bit-identical state. Builds without thread support
+    // (wasm without -pthread, or PLATFORMER_THREADS=0) always run on one.
+    void setThreadCount(int threads);
+    int getThreadCount() const;
+
+    // Sound, goal and state-change events queued since the last drain. Call once per frame
+    // after update(); the view stays valid until the next handleInput/update.
+    EventView drainEvents();
+    template <typename Visit>
+    void consumeEvents(Visit visit) { events.drain(visit); } // native: visit(event) for each, then empty
+
+    // Deterministic sessions. Effects draw from a per-Game seeded RNG. A recording captures
+    // the seed plus every handleInput/update pair (at most one handleInput per update), with
+    // a state checksum every checksumInterval frames. Start it right after loadLevel, and
+    // replay it on the same level with the same setFixedTimestep settings and physics tuning.
+    void setSeed(uint32_t seed);
+    void startRecording(uint32_t seed, uint32_t checksumInterval);
+    void stopRecording(); // finalizes the buffer returned by getRecording()
+    const std::vector<uint8_t>& getRecording() const;
+    uintptr_t getRecordingData() const;
+    uint32_t getRecordingSize() const;
+    // While a replay is active, handleInput is ignored and each update() plays the next
+    // recorded frame with its recorded deltaTime. Returns false for a malformed buffer.
+    bool startReplay(const uint8_t* data, size_t length);
+    bool startReplayFromHeap(uintptr_t ptr, uint32_t length);
+    int32_t runReplay(); // plays the rest headless, as fast as possible; returns getReplayDivergence()
+    bool isReplaying() const;
+    int32_t getReplayDivergence() const; // first frame whose checksum differed from the recording, or -1
+    uint32_t getStateChecksum() const;
     AnimationState getPlayerAnimationState() const;
+
+    // Save states for instant retry, rewinding and rollback resimulation (Snapshot.hpp
+    // layout). A snapshot holds all mutable simulation state -- entities, camera, timers,
+    // player flags, goal progress, the particle pool, the bursts and the RNG -- and refers to
+    // the level by identity, so a snapshot taken right after loading a chunked level still
+    // restores once chunks have streamed. restoreState returns false and changes nothing if
+    // the buffer is malformed, holds out-of-range values or was taken on another level. It
+    // drops any pending events and leaves the timestep settings and any recording or replay
+    // alone.
+    void saveState(std::vector<uint8_t>& out) const; // reuses out's capacity
+    bool restoreState(const uint8_t* data, size_t length);
+    uint32_t saveStateToBuffer(); // JS: saves into a buffer read via getStateData; returns its size
+    uintptr_t getStateData() const;
+    bool restoreStateFromHeap(uintptr_t ptr, uint32_t length);
+
+    // Phase times, counters and a rolling frame-time histogram for the last update() (see
+    // Profiler.hpp). The view is stable for the Game's lifetime; JS reads it in place.
+    FrameStatsView getFrameStatsView() const;
+    const FrameStats& getFrameStats() const;
+    const Profiler& getProfiler() const;
+    std::string getProfileJson() const;
 private:
-    void playSound(const std::string& soundName);
-    bool checkCollision(const Vec2& posA, const Vec2& sizeA, const Vec2& posB, const Vec2& sizeB);
-    Vec2 playerPosition;
-    Vec2 playerVelocity;
-    Vec2 playerSize;
+    void applyInput(const InputState& input);
+    void advance(float deltaTime);
+    void step(float deltaTime);
+    template <typename Fn>
+    void withTuning(Fn fn); // fn(profile struct, or the PhysicsTuning for Custom)
+    template <typename Tuning>
+    void applyInputWith(const Tuning& t, const InputState& input);
+    template <typename Tuning>
+    void stepWith(const Tuning& t, float deltaTime);
+    void emitSound(SoundId sound);
+    void dispatchCallbacks();
+    void trackSession(bool playing);
+    void applyLevel(LevelData&& level);
+    void refreshChunks();
+    void rebuildBroadphase();
+    void collectPickups(const Vec2& playerPosition, const Vec2& playerSize);
+    void moveMovers(float deltaTime);
+    void countFrame(size_t particlesEmittedBefore, size_t particlesKilledBefore);
+    size_t particlesEmitted() const; // pool and bursts, for the profiler
+    size_t particlesKilled() const;
+    Vec2 playerFeet() const;
+    size_t stateSize(uint32_t entityCount, uint32_t particleCount, uint32_t burstCount, uint32_t goalCount) const;
+    EntityStore entities;
+    MoverLayer movers;
+    bool moversDirty = true; // entity slots changed: find the moving platforms again
+    JobSystem jobs;
+    std::vector<GridScratch> workerScratch = std::vector<GridScratch>(1); // one per job participant
+    static constexpr size_t EntityGrain = 512; // bodies per physics job
     Vec2 cameraPosition;
+    Vec2 previousPlayerPosition;
+    Vec2 previousCameraPosition;
+
+    float fixedDeltaTime = 0.0f; // 0 = variable timestep
+    int maxSubsteps = 1;
+    float accumulator = 0.0f;
+    float interpolationAlpha = 1.0f;
 
     AnimationState playerAnimation;
     PlayerState currentPlayerState = PlayerState::Idle;
+    PlayerState reportedPlayerState = PlayerState::Idle; // last state sent as an event
     float animationTimer = 0.0f;
     std::vector<Platform> platforms;
+    uint32_t platformRevision = 0;
+    uint32_t levelId = 0; // levelIdentity of the loaded level, checked by restoreState
     std::vector<Platform> goals; // Goals are similar to platforms but trigger level completion when touched
     std::vector<bool> goalTriggered;
-    const float gravity = -9.8f * 2.5f;
-    const float moveSpeed = 2.0f;
-    const float jumpStrength = 6.0f;
-    bool isGrounded = false;
-    bool wasGrounded = false; // New: To track state changes for landing sound
+    PlatformGrid platformGrid;
+    PlatformSweep platformSweep; // the query API
+    PlatformGrid goalGrid;
+    GridScratch gridScratch;
+    ChunkedWorld chunkedWorld;
+    PhysicsProfile physicsProfile = PhysicsProfile::Standard;
+    PhysicsTuning tuning = tuningOf<StandardPhysics>(); // the active profile's values
     bool canJump = true;
-    emscripten::val soundCallback;
-    emscripten::val levelCompleteCallback;
+    SoundHandler soundHandler;
+    LevelCompleteHandler levelCompleteHandler;
+    EventQueue events;
     Vec2 levelMin{ -1e6f, -1e6f };
     Vec2 levelMax{ 1e6f, 1e6f };
     bool hasLevelBounds = false;
     ParticleSystem particleSystem;
+    BurstSystem bursts;
+    RenderBuffer renderBuffer;
+    StaticSpriteLayer staticSprites;
+    std::vector<SpriteRange> staticRanges; // from the last findStaticSpriteRanges
+    Random rng;
+    Profiler profiler;
+
+    // Recording and replay
+    InputState frameInput{ false, false, false };
+    bool frameHasInput = false;
+    bool recording = false;
+    ReplayRecorder recorder;
+    std::vector<uint8_t> recordingBuffer;
+    bool replaying = false;
+    std::vector<uint8_t> replayBuffer;
+    ReplayReader replayReader;
+    int32_t replayDivergence = -1;
+    uint32_t sessionFrame = 0;
+
+    std::vector<uint8_t> stateBuffer; // saveStateToBuffer
 };
 
 
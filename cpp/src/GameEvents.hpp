@@ -0,0 +1,96 @@
+#ifndef GAME_EVENTS_HPP
+#define GAME_EVENTS_HPP
+
+#include <vector>
+#include <cstdint>
+#include "Types.hpp"
+
+enum class EventType : uint32_t {
+    Sound = 1,        // code: SoundId, x/y: where it happened
+    GoalReached = 2,  // code: goal index, x/y: goal position
+    StateChanged = 3, // code: new PlayerState, x/y: player position
+    Collected = 4,    // code: entity slot the pickup occupied, x/y: pickup position
+};
+
+enum class SoundId : uint32_t {
+    Jump = 0,
+    Land = 1,
+};
+
+constexpr uint32_t SoundCount = 2;
+
+inline const char* soundName(SoundId id) {
+    switch (id) {
+        case SoundId::Jump: return "jump";
+        case SoundId::Land: return "land";
+    }
+    return "";
+}
+
+// 16-byte POD record, readable from JS as four 32-bit words.
+struct GameEvent {
+    EventType type;
+    uint32_t code;
+    float x;
+    float y;
+};
+
+static_assert(sizeof(GameEvent) == 16, "events are read from JS as four 32-bit words");
+
+// Heap location of the pending events: event i is slot (start + i) % capacity of the ring.
+struct EventView {
+    uintptr_t ptr;
+    uint32_t capacity;
+    uint32_t start;
+    uint32_t count;
+    uint32_t dropped; // events refused since the previous drain because the ring was full
+};
+
+// Fixed-capacity ring of game events, written during the simulation and drained once per
+// frame. Storage is allocated up front; when the ring is full new events are dropped and
+// counted rather than overwriting ones the host has not seen yet.
+class EventQueue {
+public:
+    static constexpr uint32_t DefaultCapacity = 256;
+
+    explicit EventQueue(uint32_t capacity = DefaultCapacity) : slots(capacity) {}
+
+    void push(EventType type, uint32_t code, float x, float y) {
+        if (count == slots.size()) {
+            ++dropped;
+            return;
+        }
+        slots[(start + count) % slots.size()] = { type, code, x, y };
+        ++count;
+    }
+
+    // Hands out the pending events and empties the queue. The slots stay untouched until the
+    // next push, so the view can be read right after the call.
+    EventView drain() {
+        EventView view = { reinterpret_cast<uintptr_t>(slots.data()), static_cast<uint32_t>(slots.size()), start, count, dropped };
+        start = (start + count) % slots.size();
+        count = 0;
+        dropped = 0;
+        return view;
+    }
+
+    // Native convenience: calls visit(event) for each pending event in order, then empties the queue.
+    template <typename Visit>
+    void drain(Visit visit) {
+        const EventView view = drain();
+        for (uint32_t i = 0; i < view.count; ++i) visit(slots[(view.start + i) % slots.size()]);
+    }
+
+    uint32_t size() const { return count; }
+
+    // Throws away the pending events without handing them out.
+    void clear() { start = count = dropped = 0; }
+
+private:
+    std::vector<GameEvent> slots;
+    uint32_t start = 0;
+    uint32_t count = 0;
+    uint32_t dropped = 0;
+};
+
+#endif // GAME_EVENTS_HPP
@@ -0,0 +1,182 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Worker threads are available natively and in wasm builds made with -pthread (which need a
+// cross-origin-isolated page for SharedArrayBuffer). Build with -DPLATFORMER_THREADS=0 to
+// compile the job system down to plain loops.
+#ifndef PLATFORMER_THREADS
+#  if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#    define PLATFORMER_THREADS 0
+#  else
+#    define PLATFORMER_THREADS 1
+#  endif
+#endif
+
+#if PLATFORMER_THREADS
+#  include <condition_variable>
+#  include <mutex>
+#  include <thread>
+#endif
+
+// Small fork-join job system for data-parallel loops over independent elements.
+//
+// parallelFor cuts [0, count) into fixed chunks and deals them out in contiguous runs, one
+// run per participant (the calling thread is participant 0). Each participant takes chunks
+// from the front of its own run and, once that is empty, steals from the other runs. Chunk
+// boundaries depend only on count and grain, never on timing or the thread count, and every
+// element is processed by exactly one call, so a loop whose iterations don't touch each
+// other produces the same bits on any number of threads. parallelFor returns only after all
+// chunks are done and every worker has let go of the job.
+class JobSystem {
+public:
+    JobSystem() = default;
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    ~JobSystem() { setThreadCount(1); }
+
+    // Total participants including the caller; clamped to [1, MaxThreads]. Always 1 without
+    // PLATFORMER_THREADS.
+    static constexpr int MaxThreads = 64;
+    void setThreadCount(int threads) {
+        threads = std::max(1, std::min(threads, MaxThreads));
+#if PLATFORMER_THREADS
+        if (threads == threadCount()) return;
+        stopWorkers();
+        runs = std::vector<Run>(threads);
+        for (int i = 1; i < threads; ++i) workers.emplace_back(&JobSystem::workerLoop, this, i, generation);
+#else
+        (void)threads;
+#endif
+    }
+
+    int threadCount() const {
+#if PLATFORMER_THREADS
+        return static_cast<int>(workers.size()) + 1;
+#else
+        return 1;
+#endif
+    }
+
+    // Calls fn(begin, end, participant) over [0, count) in chunks of `grain` elements (the
+    // last one may be shorter). `participant` is in [0, threadCount()), so callers can hand
+    // each thread its own scratch space. Runs inline when one chunk covers everything.
+    template <typename Fn>
+    void parallelFor(size_t count, size_t grain, Fn fn) {
+        if (count == 0) return;
+        grain = std::max<size_t>(grain, 1);
+#if PLATFORMER_THREADS
+        const size_t chunks = (count + grain - 1) / grain;
+        if (!workers.empty() && chunks > 1) {
+            auto trampoline = [](void* context, size_t begin, size_t end, int participant) {
+                (*static_cast<Fn*>(context))(begin, end, participant);
+            };
+            run(chunks, count, grain, trampoline, &fn);
+            return;
+        }
+#endif
+        fn(size_t{ 0 }, count, 0);
+    }
+
+private:
+#if PLATFORMER_THREADS
+    using Trampoline = void (*)(void* context, size_t begin, size_t end, int participant);
+
+    // One participant's run of chunk indices; the head is shared so other threads can steal.
+    struct alignas(64) Run {
+        std::atomic<size_t> next{ 0 };
+        size_t end = 0;
+    };
+
+    void run(size_t chunks, size_t count, size_t grain, Trampoline trampoline, void* context) {
+        const int participants = threadCount();
+        const size_t perRun = chunks / participants;
+        const size_t extra = chunks % participants;
+        size_t first = 0;
+        for (int p = 0; p < participants; ++p) {
+            const size_t length = perRun + (static_cast<size_t>(p) < extra ? 1 : 0);
+            runs[p].next.store(first, std::memory_order_relaxed);
+            runs[p].end = first + length;
+            first += length;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = { trampoline, context, count, grain };
+            finishedWorkers = 0;
+            ++generation;
+        }
+        wake.notify_all();
+        work(0);
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return finishedWorkers == workers.size(); });
+    }
+
+    // Drains the participant's own run, then steals from the others in turn.
+    void work(int participant) {
+        const int participants = threadCount();
+        for (int k = 0; k < participants; ++k) {
+            Run& r = runs[(participant + k) % participants];
+            for (;;) {
+                const size_t chunk = r.next.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= r.end) break;
+                const size_t begin = chunk * job.grain;
+                job.trampoline(job.context, begin, std::min(begin + job.grain, job.count), participant);
+            }
+        }
+    }
+
+    // `seen` is the generation at spawn time, so a job posted before the thread gets going
+    // is still picked up.
+    void workerLoop(int participant, uint64_t seen) {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            work(participant);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++finishedWorkers;
+            }
+            done.notify_one();
+        }
+    }
+
+    void stopWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : workers) t.join();
+        workers.clear();
+        stopping = false;
+    }
+
+    struct Job {
+        Trampoline trampoline = nullptr;
+        void* context = nullptr;
+        size_t count = 0;
+        size_t grain = 1;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<Run> runs;
+    Job job;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    uint64_t generation = 0;
+    size_t finishedWorkers = 0;
+    bool stopping = false;
+#endif
+};
+
+#endif // JOB_SYSTEM_HPP
@@ -0,0 +1,56 @@
+#ifndef LEVEL_FILE_HPP
+#define LEVEL_FILE_HPP
+
+// Read-only memory mapping of a binary level file for native builds, so the loader reads
+// the records straight out of the page cache. Not available under Emscripten, where level
+// buffers arrive from JS instead.
+#ifndef __EMSCRIPTEN__
+
+#include <cstddef>
+#include <cstdint>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class MappedLevelFile {
+public:
+    MappedLevelFile() = default;
+    explicit MappedLevelFile(const char* path) { open(path); }
+    ~MappedLevelFile() { close(); }
+    MappedLevelFile(const MappedLevelFile&) = delete;
+    MappedLevelFile& operator=(const MappedLevelFile&) = delete;
+
+    bool open(const char* path) {
+        close();
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                bytes = static_cast<const uint8_t*>(mapped);
+                length = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+        return bytes != nullptr;
+    }
+
+    void close() {
+        if (bytes) munmap(const_cast<uint8_t*>(bytes), length);
+        bytes = nullptr;
+        length = 0;
+    }
+
+    const uint8_t* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const uint8_t* bytes = nullptr;
+    size_t length = 0;
+};
+
+#endif // __EMSCRIPTEN__
+
+#endif // LEVEL_FILE_HPP
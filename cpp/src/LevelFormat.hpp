@@ -0,0 +1,119 @@
+#ifndef LEVEL_FORMAT_HPP
+#define LEVEL_FORMAT_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include "Types.hpp"
+
+// Compact binary level format (little-endian, every field 4 bytes):
+//
+//   offset  0  char[4]  magic "WPLV"
+//           4  uint32   version (LevelFormatVersion)
+//           8  uint32   flags (LevelHasSpawn | LevelHasBounds)
+//          12  uint32   platform count P
+//          16  uint32   goal count G
+//          20  float    chunk width W, 0 for a whole level (see ChunkedWorld.hpp)
+//          24  float[2] spawn x, y            (ignored unless LevelHasSpawn)
+//          32  float[4] bounds min x, y, max x, y (ignored unless LevelHasBounds)
+//          48  float[4 * P] platforms: position x, y, size x, y
+//              float[4 * G] goals, same layout
+//
+// A chunked level is a header with W > 0 and no records; its chunks are separate buffers in
+// the same layout holding the records that touch [k * W, (k + 1) * W).
+//
+// Platform and goal records match the in-memory Platform struct, so loading is a bulk copy
+// with no per-element work. scripts/level-binary.mjs converts the JSON levels in public/levels.
+
+constexpr uint32_t LevelFormatVersion = 1;
+constexpr uint32_t LevelHasSpawn = 1u << 0;
+constexpr uint32_t LevelHasBounds = 1u << 1;
+constexpr size_t LevelHeaderSize = 48;
+
+struct LevelData {
+    bool hasSpawn = false;
+    Vec2 spawn{ 0.0f, 0.0f };
+    bool hasBounds = false;
+    Vec2 boundsMin{ 0.0f, 0.0f };
+    Vec2 boundsMax{ 0.0f, 0.0f };
+    float chunkWidth = 0.0f;
+    std::vector<Platform> platforms;
+    std::vector<Platform> goals;
+};
+
+static_assert(sizeof(Platform) == 16, "level records are copied straight into Platform");
+
+// Decodes a level buffer. Returns false (leaving `out` untouched) if the buffer is
+// truncated, has the wrong magic, or is from an unknown format version.
+inline bool parseLevelBinary(const uint8_t* data, size_t length, LevelData& out) {
+    if (data == nullptr || length < LevelHeaderSize || std::memcmp(data, "WPLV", 4) != 0) return false;
+    uint32_t header[4];
+    std::memcpy(header, data + 4, sizeof(header));
+    const uint32_t version = header[0], flags = header[1], platformCount = header[2], goalCount = header[3];
+    if (version != LevelFormatVersion) return false;
+    const uint64_t needed = LevelHeaderSize + (static_cast<uint64_t>(platformCount) + goalCount) * sizeof(Platform);
+    if (needed > length) return false;
+
+    float fixed[6];
+    std::memcpy(&out.chunkWidth, data + 20, sizeof(float));
+    std::memcpy(fixed, data + 24, sizeof(fixed));
+    out.hasSpawn = (flags & LevelHasSpawn) != 0;
+    out.spawn = { fixed[0], fixed[1] };
+    out.hasBounds = (flags & LevelHasBounds) != 0;
+    out.boundsMin = { fixed[2], fixed[3] };
+    out.boundsMax = { fixed[4], fixed[5] };
+
+    const uint8_t* records = data + LevelHeaderSize;
+    out.platforms.resize(platformCount);
+    if (platformCount) std::memcpy(out.platforms.data(), records, platformCount * sizeof(Platform));
+    records += platformCount * sizeof(Platform);
+    out.goals.resize(goalCount);
+    if (goalCount) std::memcpy(out.goals.data(), records, goalCount * sizeof(Platform));
+    return true;
+}
+
+inline void writeLevelBinary(const LevelData& level, std::vector<uint8_t>& out) {
+    const uint32_t platformCount = static_cast<uint32_t>(level.platforms.size());
+    const uint32_t goalCount = static_cast<uint32_t>(level.goals.size());
+    out.resize(LevelHeaderSize + (platformCount + goalCount) * sizeof(Platform));
+    const uint32_t header[4] = { LevelFormatVersion,
+                                 (level.hasSpawn ? LevelHasSpawn : 0u) | (level.hasBounds ? LevelHasBounds : 0u),
+                                 platformCount, goalCount };
+    const float fixed[6] = { level.spawn.x, level.spawn.y, level.boundsMin.x, level.boundsMin.y,
+                             level.boundsMax.x, level.boundsMax.y };
+    std::memcpy(out.data(), "WPLV", 4);
+    std::memcpy(out.data() + 4, header, sizeof(header));
+    std::memcpy(out.data() + 20, &level.chunkWidth, sizeof(float));
+    std::memcpy(out.data() + 24, fixed, sizeof(fixed));
+    uint8_t* records = out.data() + LevelHeaderSize;
+    if (platformCount) std::memcpy(records, level.platforms.data(), platformCount * sizeof(Platform));
+    records += platformCount * sizeof(Platform);
+    if (goalCount) std::memcpy(records, level.goals.data(), goalCount * sizeof(Platform));
+}
+
+// Identifies a level by its contents (FNV-1a over the header fields and records, eight bytes
+// at a time), so save states can tell which level they were taken on. Loading the same level
+// again gives the same value; streaming a chunked level's chunks in and out does not touch it.
+inline uint32_t levelIdentity(const LevelData& level) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i += 8) {
+            uint64_t word = 0;
+            std::memcpy(&word, p + i, std::min<size_t>(8, size - i));
+            hash = (hash ^ word) * 1099511628211ull;
+        }
+    };
+    const uint32_t header[4] = { (level.hasSpawn ? LevelHasSpawn : 0u) | (level.hasBounds ? LevelHasBounds : 0u),
+                                 static_cast<uint32_t>(level.platforms.size()), static_cast<uint32_t>(level.goals.size()), 0u };
+    const float fixed[8] = { level.chunkWidth, level.spawn.x, level.spawn.y, level.boundsMin.x,
+                             level.boundsMin.y, level.boundsMax.x, level.boundsMax.y, 0.0f };
+    mix(header, sizeof(header));
+    mix(fixed, sizeof(fixed));
+    mix(level.platforms.data(), level.platforms.size() * sizeof(Platform));
+    mix(level.goals.data(), level.goals.size() * sizeof(Platform));
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+#endif // LEVEL_FORMAT_HPP
@@ -0,0 +1,127 @@
+#ifndef LEVEL_GENERATOR_HPP
+#define LEVEL_GENERATOR_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "Types.hpp"
+#include "LevelFormat.hpp"
+#include "Random.hpp"
+
+// The player's movement, which bounds what a generated level may ask of it.
+struct MovementLimits {
+    float gravity;      // units/s^2, negative
+    float moveSpeed;    // units/s
+    float jumpStrength; // take-off speed, units/s
+    Vec2 playerSize;
+};
+
+struct GeneratorSettings {
+    uint32_t seed = 1;
+    uint32_t platformCount = 1000; // 0 is treated as 1: a level needs a platform to spawn on
+    // 0..1. Low: wide platforms and long jumps. High: short ledges packed close together.
+    float density = 0.5f;
+};
+
+// Seeded level generator. Lays out one left-to-right run of platforms in which every hop is
+// a jump the player can make: from a standing jump off the very edge of a platform (right
+// side of the body at the edge), the feet must be above the next platform's top by the time
+// the body reaches it horizontally. The same seed and settings give the same level on every
+// platform.
+class LevelGenerator {
+public:
+    static constexpr float Thickness = 0.2f;
+    static constexpr float LowestTop = -2.0f;
+    static constexpr float HighestTop = 4.0f;
+    static constexpr float HeightMargin = 0.1f; // feet clear the next top by at least this
+    static constexpr float GapFraction = 0.85f; // of the longest gap the jump arc allows
+    static constexpr float MinGap = 0.3f;
+    static constexpr float MaxDrop = 1.5f;
+
+    // Longest edge-to-edge gap to a platform whose top is `rise` above the take-off top
+    // (negative = below); 0 if the jump cannot get that high.
+    static float longestGap(const MovementLimits& limits, float rise) {
+        const float g = -limits.gravity;
+        const float v0 = limits.jumpStrength;
+        const float discriminant = v0 * v0 - 2.0f * g * (rise + HeightMargin);
+        if (g <= 0.0f || discriminant < 0.0f) return 0.0f;
+        return limits.moveSpeed * (v0 + std::sqrt(discriminant)) / g; // time of the descending crossing
+    }
+
+    // Highest rise used between platforms: well below the jump's apex.
+    static float highestRise(const MovementLimits& limits) {
+        const float apex = limits.jumpStrength * limits.jumpStrength / (-2.0f * limits.gravity);
+        return 0.8f * (apex - HeightMargin);
+    }
+
+    static LevelData generate(const GeneratorSettings& settings, const MovementLimits& limits) {
+        LevelData level;
+        Random rng(settings.seed);
+        auto uniform = [&rng] { return static_cast<float>(rng.next() >> 8) * (1.0f / 16777216.0f); };
+        const float density = std::min(std::max(settings.density, 0.0f), 1.0f);
+        const float minWidth = std::max(0.8f, limits.playerSize.x * 1.6f);
+        const float maxWidth = minWidth + 0.4f + 3.0f * (1.0f - density);
+        const float maxRise = std::max(0.0f, highestRise(limits));
+        const uint32_t count = std::max<uint32_t>(settings.platformCount, 1);
+
+        level.platforms.reserve(count);
+        float left = -2.0f;
+        float top = 0.0f;
+        for (uint32_t i = 0; i < count; ++i) {
+            const float width = i == 0 ? 4.0f : minWidth + (maxWidth - minWidth) * uniform();
+            level.platforms.push_back({ { left + width / 2.0f, top - Thickness / 2.0f }, { width, Thickness } });
+            // The next hop: a rise or drop that stays in the height band, then a gap the jump covers.
+            const float lowest = std::max(-MaxDrop, LowestTop - top);
+            const float highest = std::min(maxRise, HighestTop - top);
+            const float rise = lowest + (highest - lowest) * uniform();
+            const float widest = std::max(MinGap, GapFraction * longestGap(limits, rise));
+            const float gap = MinGap + (widest - MinGap) * uniform() * (1.0f - 0.6f * density);
+            left += width + gap;
+            top += rise;
+        }
+
+        const Platform& first = level.platforms.front();
+        const Platform& last = level.platforms.back();
+        level.hasSpawn = true;
+        level.spawn = { first.position.x - first.size.x / 4.0f,
+                        first.position.y + Thickness / 2.0f + limits.playerSize.y / 2.0f + 0.05f };
+        const float lastTop = last.position.y + Thickness / 2.0f;
+        level.goals.push_back({ { last.position.x, lastTop + 0.5f }, { std::min(1.0f, last.size.x), 1.0f } });
+        level.hasBounds = true;
+        level.boundsMin = { first.position.x, LowestTop - 6.0f };
+        level.boundsMax = { last.position.x, HighestTop + 6.0f };
+        return level;
+    }
+};
+
+// Writes a level in the public/levels JSON layout that Game::loadLevel and
+// scripts/level-binary.mjs read. Numbers carry enough digits to come back as the same floats.
+inline void writeLevelJson(const LevelData& level, std::string& out) {
+    char buffer[160];
+    auto vec2 = [&buffer](const Vec2& v) {
+        std::snprintf(buffer, sizeof(buffer), "{ \"x\": %.9g, \"y\": %.9g }", v.x, v.y);
+        return std::string(buffer);
+    };
+    auto records = [&](const char* name, const std::vector<Platform>& list, bool more) {
+        out += "  \"";
+        out += name;
+        out += "\": [\n";
+        for (size_t i = 0; i < list.size(); ++i) {
+            out += "    { \"position\": " + vec2(list[i].position) + ", \"size\": " + vec2(list[i].size) + " }";
+            out += i + 1 < list.size() ? ",\n" : "\n";
+        }
+        out += more ? "  ],\n" : "  ]\n";
+    };
+    out.clear();
+    out.reserve(96 * (level.platforms.size() + level.goals.size()) + 256);
+    out += "{\n";
+    if (level.hasSpawn) out += "  \"spawn\": " + vec2(level.spawn) + ",\n";
+    if (level.hasBounds) out += "  \"bounds\": { \"min\": " + vec2(level.boundsMin) + ", \"max\": " + vec2(level.boundsMax) + " },\n";
+    records("platforms", level.platforms, true);
+    records("goals", level.goals, false);
+    out += "}\n";
+}
+
+#endif // LEVEL_GENERATOR_HPP
@@ -0,0 +1,172 @@
+#ifndef PARTICLE_BURSTS_HPP
+#define PARTICLE_BURSTS_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include "Types.hpp"
+
+// One emission of `count` particles from a point. Particle k's direction, speed and spin are
+// hashed from (seed, k), and it moves in a straight line at constant spin, so its state at any
+// age is a closed-form expression of the descriptor: nothing per particle is stored or
+// integrated. Velocity is base + (cos a, sin a) * speed * scale, with a, speed and spin
+// uniform in [min, min + range).
+struct ParticleBurst {
+    Vec2 origin;
+    Vec2 velocity;      // base velocity shared by every particle
+    Vec2 scale;         // per-axis multiplier on the spread
+    float angleMin;     // radians
+    float angleRange;
+    float speedMin;
+    float speedRange;
+    float spinMin;      // radians/s
+    float spinRange;
+    float lifetime;     // seconds, the same for every particle of the burst
+    float size;
+    uint32_t seed;
+    uint32_t count;
+    double spawnTime;   // on the BurstSystem clock; set by emit()
+};
+
+static_assert(sizeof(ParticleBurst) == 72, "bursts are copied raw into snapshots, so they must have no padding");
+
+// A burst particle as the renderer needs it.
+struct BurstParticle {
+    Vec2 position;
+    float rotation;
+    float alpha; // fades from 1 to 0 over the lifetime, like life / maxLife in the pool
+};
+
+// Uniform value in [0, 1) for lane `lane` of particle `index`: a stateless integer hash, so
+// any particle can be evaluated on its own, in any order.
+inline float burstRandom(uint32_t seed, uint32_t index, uint32_t lane) {
+    uint32_t h = seed ^ (index * 0x9E3779B9u + lane * 0x85EBCA6Bu);
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return static_cast<float>(h >> 8) * (1.0f / 16777216.0f);
+}
+
+// Live bursts in spawn order, aged by one clock. Cheap effects (dust, sparks) go here: emitting
+// costs one descriptor whatever the count, updating costs one comparison per burst, and a
+// burst's particles are only worked out when it is drawn. Effects that need per-particle state
+// -- collision, forces that change over time -- stay in ParticleSystem. Like the particle pool
+// it has a fixed capacity, reserved up front so nothing allocates mid-step: when it is full,
+// emit() refuses the new burst rather than cutting short one already on screen.
+class BurstSystem {
+public:
+    static constexpr uint32_t MaxBurstSize = 4096; // particles per burst; larger counts are clamped
+    static constexpr size_t DefaultCapacity = 256;  // live bursts
+
+    explicit BurstSystem(size_t capacity = DefaultCapacity) : maxBursts(capacity) { bursts.reserve(capacity); }
+
+    // Advances the clock and drops bursts whose particles have all run out of life.
+    void update(float deltaTime) {
+        now += deltaTime;
+        size_t live = 0;
+        for (const ParticleBurst& b : bursts) {
+            if (ageOf(b) >= b.lifetime) {
+                killed += b.count;
+                particles -= b.count;
+                continue;
+            }
+            bursts[live++] = b;
+        }
+        bursts.resize(live);
+    }
+
+    // Records a burst starting now. Bursts with no particles or no lifetime are skipped.
+    // Returns false if the system is full and the burst was dropped.
+    bool emit(ParticleBurst burst) {
+        burst.count = std::min(burst.count, MaxBurstSize);
+        if (burst.count == 0 || !(burst.lifetime > 0.0f)) return true;
+        if (bursts.size() == maxBursts) {
+            ++refused;
+            return false;
+        }
+        burst.spawnTime = now;
+        bursts.push_back(burst);
+        particles += burst.count;
+        emitted += burst.count;
+        return true;
+    }
+
+    float ageOf(const ParticleBurst& b) const { return static_cast<float>(now - b.spawnTime); }
+
+    // Particle k of a burst, evaluated from its descriptor.
+    static Vec2 velocityOf(const ParticleBurst& b, uint32_t k) {
+        const float angle = b.angleMin + b.angleRange * burstRandom(b.seed, k, 0);
+        const float speed = b.speedMin + b.speedRange * burstRandom(b.seed, k, 1);
+        return { b.velocity.x + std::cos(angle) * speed * b.scale.x, b.velocity.y + std::sin(angle) * speed * b.scale.y };
+    }
+    static float spinOf(const ParticleBurst& b, uint32_t k) {
+        return b.spinMin + b.spinRange * burstRandom(b.seed, k, 2);
+    }
+    static BurstParticle particleAt(const ParticleBurst& b, uint32_t k, float age) {
+        const Vec2 v = velocityOf(b, k);
+        return { { b.origin.x + v.x * age, b.origin.y + v.y * age }, spinOf(b, k) * age, (b.lifetime - age) / b.lifetime };
+    }
+
+    // Box holding every particle centre of the burst at `age` (plus a hair for rounding):
+    // the spread can reach at most the fastest speed along each axis.
+    static Aabb boundsOf(const ParticleBurst& b, float age) {
+        const float fastest = std::max(std::abs(b.speedMin), std::abs(b.speedMin + b.speedRange));
+        const Vec2 centre = { b.origin.x + b.velocity.x * age, b.origin.y + b.velocity.y * age };
+        const Vec2 spread = { fastest * std::abs(b.scale.x) * age, fastest * std::abs(b.scale.y) * age };
+        const float slack = 1e-4f * (1.0f + std::abs(centre.x) + std::abs(centre.y) + spread.x + spread.y);
+        return { { centre.x - spread.x - slack, centre.y - spread.y - slack },
+                 { centre.x + spread.x + slack, centre.y + spread.y + slack } };
+    }
+
+    void clear() {
+        bursts.clear();
+        particles = 0;
+    }
+
+    // Snapshot restore: sets the clock and copies n raw bursts from `data` (any alignment).
+    // Returns false and changes nothing unless every burst is one emit() could have recorded:
+    // at most capacity() of them, 1..MaxBurstSize particles each, a finite positive lifetime
+    // and a finite spawn time.
+    bool restore(double clock, const uint8_t* data, size_t n) {
+        if (n > maxBursts || !std::isfinite(clock)) return false;
+        for (size_t i = 0; i < n; ++i) {
+            ParticleBurst b;
+            std::memcpy(&b, data + i * sizeof(ParticleBurst), sizeof(b));
+            if (b.count == 0 || b.count > MaxBurstSize || !(b.lifetime > 0.0f) || !std::isfinite(b.lifetime) ||
+                !std::isfinite(b.spawnTime)) {
+                return false;
+            }
+        }
+        now = clock;
+        bursts.resize(n);
+        if (n) std::memcpy(bursts.data(), data, n * sizeof(ParticleBurst));
+        particles = 0;
+        for (const ParticleBurst& b : bursts) particles += b.count;
+        return true;
+    }
+
+    const std::vector<ParticleBurst>& data() const { return bursts; }
+    double clock() const { return now; }
+    size_t size() const { return bursts.size(); }
+    size_t capacity() const { return maxBursts; }
+    size_t refusedCount() const { return refused; }     // total bursts dropped because the system was full
+    size_t particleCount() const { return particles; } // live particles across all bursts
+    size_t emittedCount() const { return emitted; }     // total particles spawned
+    size_t killedCount() const { return killed; }       // total particles that ran out of life
+
+private:
+    std::vector<ParticleBurst> bursts;
+    size_t maxBursts;
+    double now = 0.0; // seconds; a double so ages stay exact over long sessions
+    size_t particles = 0;
+    size_t emitted = 0;
+    size_t killed = 0;
+    size_t refused = 0;
+};
+
+#endif // PARTICLE_BURSTS_HPP
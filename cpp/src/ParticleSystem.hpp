@@ -2,56 +2,124 @@
 #define PARTICLE_SYSTEM_HPP
 
 #include <vector>
-#include <string>
+#include <cstddef>
 #include "Types.hpp"
+#include "Simd.hpp"
+#include "JobSystem.hpp"
 
-struct Particle {
-    Vec2 position;
-    Vec2 velocity;
-    float life;      // Remaining life in seconds
-    float maxLife;   // Total life duration
-    float size;
-    float rotation;
-    float angularVelocity;
-    // We can add color or type later if needed
+// Structure-of-arrays particle storage. Every array is sized to the pool capacity up
+// front, so the storage (and any JS views over it) never moves while particles come and go.
+struct ParticleArrays {
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<float> life;      // Remaining life in seconds
+    std::vector<float> maxLife;   // Total life duration
+    std::vector<float> size;
+    std::vector<float> rotation;
+    std::vector<float> angularVelocity;
 };
 
+// Fixed-capacity particle pool. Live particles occupy [0, size()) of each array in
+// spawn order. When the pool is full, emit() refuses the new particle rather than
+// evicting a live one, so a burst never cuts short particles already on screen.
 class ParticleSystem {
 public:
-    ParticleSystem() {}
-
-    void update(float deltaTime) {
-        for (auto it = particles.begin(); it != particles.end(); ) {
-            it->life -= deltaTime;
-            if (it->life <= 0) {
-                it = particles.erase(it);
-            } else {
-                it->position.x += it->velocity.x * deltaTime;
-                it->position.y += it->velocity.y * deltaTime;
-                it->rotation += it->angularVelocity * deltaTime;
-                ++it;
-            }
+    static constexpr size_t DefaultCapacity = 4096;
+    // Particles per integration job. A multiple of the SIMD width, so every particle takes
+    // the same vector-or-scalar path whatever the thread count.
+    static constexpr size_t IntegrateGrain = 2048;
+
+    explicit ParticleSystem(size_t capacity = DefaultCapacity) { setCapacity(capacity); }
+
+    // Resizes the pool. Live particles beyond the new capacity are discarded.
+    void setCapacity(size_t newCapacity) {
+        forEachField([newCapacity](std::vector<float>& field) { field.resize(newCapacity); });
+        maxParticles = newCapacity;
+        if (count > maxParticles) count = maxParticles;
+    }
+
+    // Integration is split across `jobs` when given; compaction stays on the calling thread.
+    void update(float deltaTime, JobSystem* jobs = nullptr) {
+        const size_t n = count;
+        float* life = data.life.data();
+        auto integrate = [this, deltaTime, life](size_t begin, size_t end, int) {
+            integrateParticles(end - begin, deltaTime, data.positionX.data() + begin, data.positionY.data() + begin,
+                      data.rotation.data() + begin, life + begin, data.velocityX.data() + begin,
+                      data.velocityY.data() + begin, data.angularVelocity.data() + begin);
+        };
+        if (jobs) jobs->parallelFor(n, IntegrateGrain, integrate);
+        else integrate(0, n, 0);
+
+        // Compact survivors to the front, preserving spawn (and therefore draw) order.
+        size_t live = 0;
+        while (live < n && life[live] > 0) ++live;
+        for (size_t i = live; i < n; ++i) {
+            if (life[i] <= 0) continue;
+            forEachField([i, live](std::vector<float>& field) { field[live] = field[i]; });
+            ++live;
         }
+        killed += n - live;
+        count = live;
     }
 
-    void emit(Vec2 position, Vec2 velocity, float life, float size, float angularVelocity = 0.0f) {
-        Particle p;
-        p.position = position;
-        p.velocity = velocity;
-        p.life = life;
-        p.maxLife = life;
-        p.size = size;
-        p.rotation = 0.0f;
-        p.angularVelocity = angularVelocity;
-        particles.push_back(p);
+    // Returns false if the pool is full and the particle was dropped.
+    bool emit(Vec2 position, Vec2 velocity, float life, float size, float angularVelocity = 0.0f) {
+        if (count == maxParticles) {
+            ++refused;
+            return false;
+        }
+        const size_t i = count++;
+        ++emitted;
+        data.positionX[i] = position.x;
+        data.positionY[i] = position.y;
+        data.velocityX[i] = velocity.x;
+        data.velocityY[i] = velocity.y;
+        data.life[i] = life;
+        data.maxLife[i] = life;
+        data.size[i] = size;
+        data.rotation[i] = 0.0f;
+        data.angularVelocity[i] = angularVelocity;
+        return true;
     }
 
-    const std::vector<Particle>& getParticles() const {
-        return particles;
+    void clear() { count = 0; }
+
+    // Sets the live count (clamped to the capacity) without touching the fields; snapshot
+    // restore fills them in afterwards.
+    void resize(size_t live) { count = live < maxParticles ? live : maxParticles; }
+
+    const ParticleArrays& arrays() const { return data; }
+    size_t size() const { return count; }
+    size_t capacity() const { return maxParticles; }
+    size_t refusedCount() const { return refused; } // total emits dropped because the pool was full
+    size_t emittedCount() const { return emitted; } // total particles spawned
+    size_t killedCount() const { return killed; }   // total particles that ran out of life
+
+    // Calls fn(array) for every per-particle field, always in the same order.
+    template <typename Fn>
+    void forEachField(Fn fn) {
+        fn(data.positionX);
+        fn(data.positionY);
+        fn(data.velocityX);
+        fn(data.velocityY);
+        fn(data.life);
+        fn(data.maxLife);
+        fn(data.size);
+        fn(data.rotation);
+        fn(data.angularVelocity);
     }
+    template <typename Fn>
+    void forEachField(Fn fn) const { const_cast<ParticleSystem*>(this)->forEachField([&fn](const std::vector<float>& field) { fn(field); }); }
 
 private:
-    std::vector<Particle> particles;
+    ParticleArrays data;
+    size_t count = 0;
+    size_t maxParticles = 0;
+    size_t refused = 0;
+    size_t emitted = 0;
+    size_t killed = 0;
 };
 
 #endif // PARTICLE_SYSTEM_HPP
@@ -0,0 +1,63 @@
+#ifndef PHYSICS_PROFILE_HPP
+#define PHYSICS_PROFILE_HPP
+
+#include <cstdint>
+
+// Movement, ground probe, effect and animation tuning that every simulation step reads.
+// PhysicsTuning holds the values at run time, for level designers adjusting them live. The
+// profile structs hold them as static constexpr members instead: a step specialized on a
+// profile (see Game::setPhysicsProfile) has them folded into the code, and emission loops a
+// profile zeroes compile away. Both are read the same way -- tuning.gravity -- so one
+// template serves either.
+struct PhysicsTuning {
+    float gravity;              // units/s^2, negative
+    float moveSpeed;            // units/s
+    float jumpStrength;         // take-off speed, units/s
+    float enemySpeed;           // patrol speed, units/s
+    float groundCheckDistance;  // gap between the feet and the ground probe box
+    uint32_t jumpParticles;     // emitted per jump
+    uint32_t landParticles;     // emitted per landing
+    uint32_t runParticleChance; // percent of running steps that kick up a dust particle
+    float frameDuration;        // seconds per animation frame
+};
+
+enum class PhysicsProfile : uint32_t {
+    Standard = 0, // the shipped tuning
+    LowFx = 1,    // Standard movement, particles compiled out
+    HighFx = 2,   // Standard movement, three times the particles
+    Custom = 3,   // PhysicsTuning values read at run time
+};
+
+struct StandardPhysics {
+    static constexpr float gravity = -9.8f * 2.5f;
+    static constexpr float moveSpeed = 2.0f;
+    static constexpr float jumpStrength = 6.0f;
+    static constexpr float enemySpeed = 1.0f;
+    static constexpr float groundCheckDistance = 0.05f;
+    static constexpr uint32_t jumpParticles = 10;
+    static constexpr uint32_t landParticles = 10;
+    static constexpr uint32_t runParticleChance = 10;
+    static constexpr float frameDuration = 0.25f;
+};
+
+struct LowFxPhysics : StandardPhysics {
+    static constexpr uint32_t jumpParticles = 0;
+    static constexpr uint32_t landParticles = 0;
+    static constexpr uint32_t runParticleChance = 0;
+};
+
+struct HighFxPhysics : StandardPhysics {
+    static constexpr uint32_t jumpParticles = 30;
+    static constexpr uint32_t landParticles = 30;
+    static constexpr uint32_t runParticleChance = 30;
+};
+
+// A profile's values as run-time tuning.
+template <typename Profile>
+constexpr PhysicsTuning tuningOf() {
+    return { Profile::gravity, Profile::moveSpeed, Profile::jumpStrength, Profile::enemySpeed,
+             Profile::groundCheckDistance, Profile::jumpParticles, Profile::landParticles,
+             Profile::runParticleChance, Profile::frameDuration };
+}
+
+#endif // PHYSICS_PROFILE_HPP
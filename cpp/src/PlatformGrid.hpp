@@ -0,0 +1,265 @@
+#ifndef PLATFORM_GRID_HPP
+#define PLATFORM_GRID_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include "Types.hpp"
+#include "Simd.hpp"
+#include "Profiler.hpp"
+
+// Per-caller scratch space for grid queries. Kept outside the grid so the grid itself
+// stays read-only once built and queries never allocate after warm-up.
+struct GridScratch {
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> stamps; // stamps[i] == epoch when platform i is already collected
+    uint32_t epoch = 0;
+    uint64_t tests = 0; // candidates collected since the owner last reset it (profiling only)
+};
+
+// Uniform-grid broadphase over a static list of platforms. Cells are stored CSR-style
+// (one offsets array plus one flat index array), and each cell lists its platforms in
+// ascending index order.
+class PlatformGrid {
+public:
+    // Builds the grid. cellSize <= 0 picks a size from the average platform extent.
+    void build(const std::vector<Platform>& platforms, float cellSize = 0.0f) {
+        count = static_cast<uint32_t>(platforms.size());
+        cellStart.clear();
+        cellItems.clear();
+        minX.resize(count);
+        minY.resize(count);
+        maxX.resize(count);
+        maxY.resize(count);
+        thinnest = { INFINITY, INFINITY };
+        for (uint32_t i = 0; i < count; ++i) {
+            Aabb box = boxOf(platforms[i].position, platforms[i].size);
+            minX[i] = box.min.x;
+            minY[i] = box.min.y;
+            maxX[i] = box.max.x;
+            maxY[i] = box.max.y;
+            thinnest.x = std::min(thinnest.x, box.max.x - box.min.x);
+            thinnest.y = std::min(thinnest.y, box.max.y - box.min.y);
+        }
+        if (platforms.empty()) {
+            cols = rows = 0;
+            return;
+        }
+
+        Vec2 lo = { INFINITY, INFINITY };
+        Vec2 hi = { -INFINITY, -INFINITY };
+        float extentSum = 0.0f;
+        for (uint32_t i = 0; i < count; ++i) {
+            lo.x = std::min(lo.x, minX[i]);
+            lo.y = std::min(lo.y, minY[i]);
+            hi.x = std::max(hi.x, maxX[i]);
+            hi.y = std::max(hi.y, maxY[i]);
+            extentSum += std::max(platforms[i].size.x, platforms[i].size.y);
+        }
+        if (cellSize <= 0.0f) {
+            cellSize = std::max(1.0f, 2.0f * extentSum / static_cast<float>(platforms.size()));
+        }
+        // Keep the dense cell array proportional to the platform count for sparse,
+        // very wide or very tall levels.
+        const double maxCells = 4.0 * platforms.size() + 1024.0;
+        while (std::ceil((hi.x - lo.x) / cellSize + 1.0) * std::ceil((hi.y - lo.y) / cellSize + 1.0) > maxCells) {
+            cellSize *= 2.0f;
+        }
+
+        origin = lo;
+        invCellSize = 1.0f / cellSize;
+        cols = static_cast<int>((hi.x - lo.x) * invCellSize) + 1;
+        rows = static_cast<int>((hi.y - lo.y) * invCellSize) + 1;
+
+        cellStart.assign(static_cast<size_t>(cols) * rows + 1, 0);
+        for (uint32_t i = 0; i < count; ++i) {
+            CellRange r = cellsOf(boundsOf(i));
+            for (int cy = r.y0; cy <= r.y1; ++cy)
+                for (int cx = r.x0; cx <= r.x1; ++cx)
+                    ++cellStart[cellIndex(cx, cy) + 1];
+        }
+        for (size_t c = 1; c < cellStart.size(); ++c) cellStart[c] += cellStart[c - 1];
+        cellItems.resize(cellStart.back());
+        fill.assign(cellStart.begin(), cellStart.end() - 1);
+        for (uint32_t i = 0; i < count; ++i) {
+            CellRange r = cellsOf(boundsOf(i));
+            for (int cy = r.y0; cy <= r.y1; ++cy)
+                for (int cx = r.x0; cx <= r.x1; ++cx)
+                    cellItems[fill[cellIndex(cx, cy)]++] = i;
+        }
+    }
+
+    // Smallest platform width and height (infinite when empty). A body moving less than its
+    // own size plus this along an axis cannot pass all the way through a platform.
+    Vec2 thinnestExtent() const { return thinnest; }
+
+    Aabb boundsOf(uint32_t index) const { return { { minX[index], minY[index] }, { maxX[index], maxY[index] } }; }
+
+    // Same bounds checkCollision derives from a centre/size pair, so that anything it
+    // reports as overlapping is guaranteed to share at least one cell.
+    static Aabb boxOf(const Vec2& pos, const Vec2& size) {
+        return { { pos.x - size.x / 2.0f, pos.y - size.y / 2.0f },
+                 { pos.x + size.x / 2.0f, pos.y + size.y / 2.0f } };
+    }
+
+    static Aabb merge(const Aabb& a, const Aabb& b) {
+        return { { std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y) },
+                 { std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y) } };
+    }
+
+    // Collects every platform sharing a cell with `box`, sorted by index, into scratch.candidates.
+    void query(const Aabb& box, GridScratch& scratch) const {
+        beginQuery(scratch);
+        if (cols == 0) return;
+        collect(cellsOf(box), CellRange::none(), scratch);
+        std::sort(scratch.candidates.begin(), scratch.candidates.end());
+    }
+
+    // Bit k is set when platform indices[k] (k < n <= 4) overlaps box, using the same strict
+    // test as checkCollision. Gathers the bounds so the four tests run as one SIMD compare.
+    unsigned overlapMask(const Aabb& box, const uint32_t* indices, size_t n) const {
+        // Padding lanes get inverted infinite bounds, which can never overlap anything.
+        alignas(16) float lx[4] = { INFINITY, INFINITY, INFINITY, INFINITY };
+        alignas(16) float ly[4] = { INFINITY, INFINITY, INFINITY, INFINITY };
+        alignas(16) float hx[4] = { -INFINITY, -INFINITY, -INFINITY, -INFINITY };
+        alignas(16) float hy[4] = { -INFINITY, -INFINITY, -INFINITY, -INFINITY };
+        for (size_t k = 0; k < n; ++k) {
+            lx[k] = minX[indices[k]];
+            ly[k] = minY[indices[k]];
+            hx[k] = maxX[indices[k]];
+            hy[k] = maxY[indices[k]];
+        }
+        return overlapMask4(box, lx, ly, hx, hy);
+    }
+
+    // True if any collected candidate overlaps box.
+    bool anyOverlap(const Aabb& box, const GridScratch& scratch) const {
+        const auto& c = scratch.candidates;
+        for (size_t i = 0; i < c.size(); i += 4) {
+            if (overlapMask(box, c.data() + i, std::min<size_t>(4, c.size() - i))) return true;
+        }
+        return false;
+    }
+
+    // Calls visit(index) for every platform that overlaps currentBox() at the moment it is
+    // reached, in ascending platform index order -- the order a full scan of the platform
+    // list uses. `region` is the initial query box (e.g. the swept AABB). Candidates are
+    // tested four at a time. If a visit pushes the body outside the cells queried so far,
+    // the region grows and any newly reachable platforms later in the order are merged
+    // into the walk, so order-dependent resolution produces exactly what the brute-force
+    // loop would.
+    template <typename BoxFn, typename Visit>
+    void walkInOrder(const Aabb& region, BoxFn currentBox, Visit visit, GridScratch& scratch) const {
+        beginQuery(scratch);
+        if (cols == 0) return;
+        CellRange queried = cellsOf(region);
+        collect(queried, CellRange::none(), scratch);
+        auto& c = scratch.candidates;
+        std::sort(c.begin(), c.end());
+        size_t i = 0;
+        while (i < c.size()) {
+            const size_t batch = std::min<size_t>(4, c.size() - i);
+            const unsigned mask = overlapMask(currentBox(), c.data() + i, batch);
+            if (mask == 0) {
+                i += batch;
+                continue;
+            }
+            i += static_cast<size_t>(__builtin_ctz(mask));
+            const uint32_t index = c[i++];
+            visit(index);
+            CellRange now = cellsOf(currentBox());
+            if (queried.contains(now)) continue;
+            CellRange grown = queried.merge(now);
+            const size_t before = c.size();
+            collect(grown, queried, scratch);
+            queried = grown;
+            // Platforms earlier in the order were already passed while the body was inside
+            // the old region, where they could not have overlapped it.
+            c.erase(std::remove_if(c.begin() + before, c.end(), [index](uint32_t k) { return k < index; }), c.end());
+            std::sort(c.begin() + i, c.end());
+        }
+    }
+
+    bool empty() const { return count == 0; }
+
+private:
+    struct CellRange {
+        int x0, y0, x1, y1;
+        static CellRange none() { return { 0, 0, -1, -1 }; }
+        bool has(int cx, int cy) const { return cx >= x0 && cx <= x1 && cy >= y0 && cy <= y1; }
+        bool contains(const CellRange& o) const { return o.x0 >= x0 && o.x1 <= x1 && o.y0 >= y0 && o.y1 <= y1; }
+        CellRange merge(const CellRange& o) const {
+            return { std::min(x0, o.x0), std::min(y0, o.y0), std::max(x1, o.x1), std::max(y1, o.y1) };
+        }
+    };
+
+    int clampCell(float v, int n) const {
+        // Clamp in float first so far-away coordinates cannot overflow the int conversion.
+        float c = std::floor(v);
+        if (!(c > 0.0f)) return 0;
+        if (c >= static_cast<float>(n - 1)) return n - 1;
+        return static_cast<int>(c);
+    }
+
+    CellRange cellsOf(const Aabb& box) const {
+        return { clampCell((box.min.x - origin.x) * invCellSize, cols),
+                 clampCell((box.min.y - origin.y) * invCellSize, rows),
+                 clampCell((box.max.x - origin.x) * invCellSize, cols),
+                 clampCell((box.max.y - origin.y) * invCellSize, rows) };
+    }
+
+    size_t cellIndex(int cx, int cy) const { return static_cast<size_t>(cy) * cols + cx; }
+
+    void beginQuery(GridScratch& scratch) const {
+        // Room for any ordinary query up front, rather than a doubling now and then mid-run.
+        if (scratch.candidates.capacity() < MinCandidates) scratch.candidates.reserve(MinCandidates);
+        scratch.candidates.clear();
+        if (scratch.stamps.size() < count) scratch.stamps.resize(count, 0);
+        if (++scratch.epoch == 0) { // wrapped: old stamps could alias the new epoch
+            std::fill(scratch.stamps.begin(), scratch.stamps.end(), 0);
+            scratch.epoch = 1;
+        }
+    }
+
+    // Appends platforms from cells in `range` but not in `skip`, once each.
+    void collect(const CellRange& range, const CellRange& skip, GridScratch& scratch) const {
+#if PLATFORMER_PROFILE
+        const size_t before = scratch.candidates.size();
+#endif
+        for (int cy = range.y0; cy <= range.y1; ++cy) {
+            for (int cx = range.x0; cx <= range.x1; ++cx) {
+                if (skip.has(cx, cy)) continue;
+                const size_t cell = cellIndex(cx, cy);
+                for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; ++k) {
+                    const uint32_t index = cellItems[k];
+                    if (scratch.stamps[index] == scratch.epoch) continue;
+                    scratch.stamps[index] = scratch.epoch;
+                    scratch.candidates.push_back(index);
+                }
+            }
+        }
+#if PLATFORMER_PROFILE
+        scratch.tests += scratch.candidates.size() - before;
+#endif
+    }
+
+    static constexpr size_t MinCandidates = 64;
+
+    Vec2 origin{ 0.0f, 0.0f };
+    float invCellSize = 1.0f;
+    int cols = 0;
+    int rows = 0;
+    uint32_t count = 0;
+    Vec2 thinnest{ INFINITY, INFINITY };
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> cellItems;
+    std::vector<uint32_t> fill; // build's write cursors, kept so rebuilding every step stops allocating
+    // Per-platform bounds in SoA form for the batched overlap test.
+    std::vector<float> minX;
+    std::vector<float> minY;
+    std::vector<float> maxX;
+    std::vector<float> maxY;
+};
+
+#endif // PLATFORM_GRID_HPP
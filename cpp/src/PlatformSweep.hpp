@@ -0,0 +1,236 @@
+#ifndef PLATFORM_SWEEP_HPP
+#define PLATFORM_SWEEP_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+#include "Types.hpp"
+
+// First platform a ray (or a downward cast) ran into.
+struct RayHit {
+    bool hit;
+    uint32_t platform; // index into the platform list
+    float distance;    // along the ray, in multiples of its direction vector
+    Vec2 point;        // where the ray enters the platform
+    Vec2 normal;       // face it entered through; (0, 0) if the ray starts inside
+};
+
+// Sorts platforms into width classes, each at most twice as wide as the one below: class c
+// holds the widths in (narrowest * 2^(c-1), narrowest * 2^c]. Fills classOf (one entry per
+// platform) and returns the number of classes. A search that must reach back by the widest
+// box it may meet does so per class, so one long floor does not widen it for every ledge.
+inline uint32_t widthClasses(const std::vector<Platform>& platforms, std::vector<uint32_t>& classOf) {
+    auto widthOf = [&platforms](size_t i) {
+        const Platform& p = platforms[i];
+        return (p.position.x + p.size.x / 2.0f) - (p.position.x - p.size.x / 2.0f);
+    };
+    float narrowest = INFINITY;
+    for (size_t i = 0; i < platforms.size(); ++i) narrowest = std::min(narrowest, widthOf(i));
+    narrowest = std::max(narrowest, 1e-3f);
+    classOf.resize(platforms.size());
+    uint32_t classes = platforms.empty() ? 0 : 1;
+    for (size_t i = 0; i < platforms.size(); ++i) {
+        uint32_t c = 0;
+        for (float limit = narrowest; widthOf(i) > limit; limit *= 2.0f) ++c;
+        classOf[i] = c;
+        classes = std::max(classes, c + 1);
+    }
+    return classes;
+}
+
+// Sweep-and-prune lists over a static set of platforms. The platforms are split into width
+// classes, each at most twice as wide as the one below, and each class keeps its boxes sorted
+// by left edge plus the running maximum of their right edges. Every platform of a class
+// overlapping an x interval sits in one contiguous run, found with two binary searches -- the
+// first slot whose running reach gets past the interval, and the first whose left edge is
+// beyond it -- and then scanned in order. Splitting by width keeps one long platform (a floor
+// under the whole level) from holding the running reach up for every narrow ledge after it.
+// Queries are const, allocation-free and safe to run from several threads at once.
+//
+// Boxes are derived from centre/size exactly as checkCollision and PlatformGrid do, so the
+// overlap tests here agree with them bit for bit.
+class PlatformSweep {
+public:
+    void build(const std::vector<Platform>& platforms) {
+        const uint32_t count = static_cast<uint32_t>(platforms.size());
+        index.resize(count);
+        std::iota(index.begin(), index.end(), 0u);
+        auto boxOf = [&platforms](uint32_t i) {
+            const Platform& p = platforms[i];
+            return Aabb{ { p.position.x - p.size.x / 2.0f, p.position.y - p.size.y / 2.0f },
+                         { p.position.x + p.size.x / 2.0f, p.position.y + p.size.y / 2.0f } };
+        };
+        std::vector<uint32_t> widthClass;
+        const uint32_t classes = widthClasses(platforms, widthClass);
+        std::stable_sort(index.begin(), index.end(), [&](uint32_t a, uint32_t b) {
+            if (widthClass[a] != widthClass[b]) return widthClass[a] < widthClass[b];
+            return boxOf(a).min.x < boxOf(b).min.x;
+        });
+        boxes.resize(count);
+        left.resize(count);
+        reach.resize(count);
+        classStart.assign(classes + 1, count);
+        float running = -INFINITY;
+        for (uint32_t s = count; s-- > 0;) classStart[widthClass[index[s]]] = s;
+        for (uint32_t c = classes; c-- > 0;) classStart[c] = std::min(classStart[c], classStart[c + 1]); // empty classes
+        for (uint32_t s = 0; s < count; ++s) {
+            boxes[s] = boxOf(index[s]);
+            left[s] = boxes[s].min.x;
+            if (s == classStart[widthClass[index[s]]]) running = -INFINITY;
+            running = std::max(running, boxes[s].max.x);
+            reach[s] = running;
+        }
+    }
+
+    // Calls visit(platform) for every platform overlapping box (touching edges do not count,
+    // as in checkCollision): narrowest class first, each class in left-edge order.
+    template <typename Visit>
+    void forEachOverlap(const Aabb& box, Visit visit) const {
+        for (uint32_t c = 0; c + 1 < classStart.size(); ++c) {
+            const uint32_t end = endBefore(c, box.max.x);
+            for (uint32_t s = firstPast(c, box.min.x); s < end; ++s) {
+                const Aabb& b = boxes[s];
+                if (b.max.x > box.min.x && b.min.y < box.max.y && b.max.y > box.min.y) visit(index[s]);
+            }
+        }
+    }
+
+    bool anyOverlap(const Aabb& box) const {
+        for (uint32_t c = 0; c + 1 < classStart.size(); ++c) {
+            const uint32_t end = endBefore(c, box.max.x);
+            for (uint32_t s = firstPast(c, box.min.x); s < end; ++s) {
+                const Aabb& b = boxes[s];
+                if (b.max.x > box.min.x && b.min.y < box.max.y && b.max.y > box.min.y) return true;
+            }
+        }
+        return false;
+    }
+
+    // Drops the span (minX, maxX) from height fromY down to toY and reports the highest
+    // platform it meets: one overlapping the span and the interval (toY, fromY), strictly.
+    // Its distance is how far below fromY its top is (0 if the top is above fromY). Ties go
+    // to the lower platform index. A zero-width span casts a single vertical ray. `scanned`,
+    // if given, is increased by the number of boxes looked at.
+    RayHit castDown(float minX, float maxX, float fromY, float toY, uint32_t* scanned = nullptr) const {
+        RayHit result = miss();
+        for (uint32_t c = 0; c + 1 < classStart.size(); ++c) {
+            const uint32_t first = firstPast(c, minX);
+            const uint32_t end = endBefore(c, maxX);
+            for (uint32_t s = first; s < end; ++s) {
+                const Aabb& b = boxes[s];
+                if (!(b.max.x > minX && b.min.y < fromY && b.max.y > toY)) continue;
+                const float top = std::min(b.max.y, fromY);
+                if (result.hit && (top < result.point.y || (top == result.point.y && index[s] > result.platform))) continue;
+                result = { true, index[s], fromY - top, { 0.0f, top }, { 0.0f, b.max.y <= fromY ? 1.0f : 0.0f } };
+            }
+            if (scanned) *scanned += end > first ? end - first : 0;
+        }
+        if (result.hit) result.point.x = minX == maxX ? minX : (minX + maxX) / 2.0f;
+        return result;
+    }
+
+    // Nearest platform top at or below point, at most maxDistance down.
+    RayHit groundBelow(const Vec2& point, float maxDistance) const {
+        return castDown(point.x, point.x, point.y, point.y - maxDistance);
+    }
+
+    // First platform hit by the segment origin + t * direction, t in [0, maxDistance]; ties
+    // go to the lower platform index. Touching a face counts as a hit. Each class is scanned
+    // in the ray's x direction and left once no remaining box in it can be entered any earlier.
+    RayHit raycast(const Vec2& origin, const Vec2& direction, float maxDistance) const {
+        RayHit result = miss();
+        if (boxes.empty() || !(maxDistance >= 0.0f)) return result;
+        const float endX = origin.x + direction.x * maxDistance;
+        // Widened by a hair so rounding in endX never drops a box the slab test would hit.
+        const float slack = 1e-5f * (1.0f + std::abs(origin.x) + std::abs(endX));
+        auto consider = [&](uint32_t s) {
+            float t;
+            Vec2 normal;
+            if (!enter(boxes[s], origin, direction, maxDistance, t, normal)) return;
+            if (result.hit && (t > result.distance || (t == result.distance && index[s] > result.platform))) return;
+            result = { true, index[s], t, { origin.x + direction.x * t, origin.y + direction.y * t }, normal };
+        };
+        for (uint32_t c = 0; c + 1 < classStart.size(); ++c) {
+            const uint32_t first = firstReaching(c, std::min(origin.x, endX) - slack);
+            const uint32_t end = endAfter(c, std::max(origin.x, endX) + slack);
+            if (direction.x > 0.0f) {
+                const float inv = 1.0f / direction.x;
+                for (uint32_t s = first; s < end; ++s) {
+                    if (result.hit && (left[s] - origin.x) * inv > result.distance) break; // later boxes start further right
+                    consider(s);
+                }
+            } else if (direction.x < 0.0f) {
+                const float inv = 1.0f / direction.x;
+                for (uint32_t s = end; s-- > first;) {
+                    if (result.hit && (reach[s] - origin.x) * inv > result.distance) break; // earlier boxes end further left
+                    consider(s);
+                }
+            } else {
+                for (uint32_t s = first; s < end; ++s) consider(s);
+            }
+        }
+        return result;
+    }
+
+    // Ray entry into box within [0, maxDistance] (slab test).
+    static bool enter(const Aabb& box, const Vec2& origin, const Vec2& direction, float maxDistance, float& t, Vec2& normal) {
+        float tMin = 0.0f;
+        float tMax = maxDistance;
+        normal = { 0.0f, 0.0f };
+        if (!clipSlab(box.min.x, box.max.x, origin.x, direction.x, tMin, tMax, normal, { 1.0f, 0.0f })) return false;
+        if (!clipSlab(box.min.y, box.max.y, origin.y, direction.y, tMin, tMax, normal, { 0.0f, 1.0f })) return false;
+        t = tMin;
+        return true;
+    }
+
+    size_t size() const { return boxes.size(); }
+
+private:
+    static RayHit miss() { return { false, 0, 0.0f, { 0.0f, 0.0f }, { 0.0f, 0.0f } }; }
+
+    static bool clipSlab(float lo, float hi, float o, float d, float& tMin, float& tMax, Vec2& normal, Vec2 axis) {
+        if (d == 0.0f) return o >= lo && o <= hi;
+        const float inv = 1.0f / d;
+        float t0 = (lo - o) * inv;
+        float t1 = (hi - o) * inv;
+        float side = -1.0f; // moving up the axis enters through the low face
+        if (t0 > t1) {
+            std::swap(t0, t1);
+            side = 1.0f;
+        }
+        if (t0 > tMin) {
+            tMin = t0;
+            normal = { axis.x * side, axis.y * side };
+        }
+        tMax = std::min(tMax, t1);
+        return tMin <= tMax;
+    }
+
+    // Slot searches within class c.
+    // First slot whose running right edge is past x (strictly): nothing before it reaches x.
+    uint32_t firstPast(uint32_t c, float x) const {
+        return static_cast<uint32_t>(std::upper_bound(reach.begin() + classStart[c], reach.begin() + classStart[c + 1], x) - reach.begin());
+    }
+    // First slot whose running right edge reaches x.
+    uint32_t firstReaching(uint32_t c, float x) const {
+        return static_cast<uint32_t>(std::lower_bound(reach.begin() + classStart[c], reach.begin() + classStart[c + 1], x) - reach.begin());
+    }
+    // One past the last slot whose left edge is before x (strictly).
+    uint32_t endBefore(uint32_t c, float x) const {
+        return static_cast<uint32_t>(std::lower_bound(left.begin() + classStart[c], left.begin() + classStart[c + 1], x) - left.begin());
+    }
+    // One past the last slot whose left edge is at or before x.
+    uint32_t endAfter(uint32_t c, float x) const {
+        return static_cast<uint32_t>(std::upper_bound(left.begin() + classStart[c], left.begin() + classStart[c + 1], x) - left.begin());
+    }
+
+    std::vector<Aabb> boxes;          // by width class, then left edge
+    std::vector<float> left;          // boxes[s].min.x, for the binary search
+    std::vector<float> reach;         // max of the class's boxes up to s of .max.x, non-decreasing per class
+    std::vector<uint32_t> index;      // platform index per slot
+    std::vector<uint32_t> classStart; // first slot of each width class, plus the end
+};
+
+#endif // PLATFORM_SWEEP_HPP
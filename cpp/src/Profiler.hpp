@@ -0,0 +1,331 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Per-frame instrumentation of Game::update. Off by default, so shipping builds compile every
+// timer and counter down to nothing (the stats then stay zero); profiling builds define
+// PLATFORMER_PROFILE=1 (npm run build:wasm:profile, and the native benchmarks).
+#ifndef PLATFORMER_PROFILE
+#  define PLATFORMER_PROFILE 0
+#endif
+
+// Timed sections of a frame. The frame itself (one update() call) is timed separately.
+enum class ProfilePhase : uint32_t {
+    Particles = 0,   // particle integration and compaction, burst expiry
+    GroundProbe = 1, // patrol + ground probe pass over the entities
+    Emission = 2,    // landing and running effects
+    Movement = 3,    // gravity + swept/Y/X collision + state pass over the entities
+    Triggers = 4,    // pickups and goal checks
+    Callbacks = 5,   // sound / level-complete handlers
+};
+
+constexpr uint32_t ProfilePhaseCount = 6;
+
+enum class ProfileCounter : uint32_t {
+    Steps = 0,            // simulation ticks run by the frame
+    CollisionTests = 1,   // broadphase candidates handed to the narrow-phase box tests
+    ParticlesAlive = 2,   // at the end of the frame, pooled and in bursts
+    ParticlesEmitted = 3,
+    ParticlesKilled = 4,
+    CallbacksFired = 5,
+    BytesAllocated = 6,   // only counted when the host's operator new calls profileAllocation
+};
+
+constexpr uint32_t ProfileCounterCount = 7;
+
+// Frame times go into power-of-two microsecond buckets: bucket 0 is < 2 us, bucket b is
+// [2^b, 2^(b+1)) us, and the last bucket takes everything from 2^15 us (~33 ms) up.
+constexpr uint32_t FrameHistogramBuckets = 16;
+constexpr uint32_t FrameHistogramWindow = 240; // frames the histogram (and average/max) cover
+
+inline const char* profilePhaseName(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::Particles: return "particles";
+        case ProfilePhase::GroundProbe: return "groundProbe";
+        case ProfilePhase::Emission: return "emission";
+        case ProfilePhase::Movement: return "movement";
+        case ProfilePhase::Triggers: return "triggers";
+        case ProfilePhase::Callbacks: return "callbacks";
+    }
+    return "";
+}
+
+inline const char* profileCounterName(ProfileCounter counter) {
+    switch (counter) {
+        case ProfileCounter::Steps: return "steps";
+        case ProfileCounter::CollisionTests: return "collisionTests";
+        case ProfileCounter::ParticlesAlive: return "particlesAlive";
+        case ProfileCounter::ParticlesEmitted: return "particlesEmitted";
+        case ProfileCounter::ParticlesKilled: return "particlesKilled";
+        case ProfileCounter::CallbacksFired: return "callbacksFired";
+        case ProfileCounter::BytesAllocated: return "bytesAllocated";
+    }
+    return "";
+}
+
+// Bytes requested from the global allocator so far. Hosts that want BytesAllocated replace
+// operator new and call profileAllocation from it: profiling builds link AllocationHook.cpp,
+// release builds keep the standard allocator.
+inline std::atomic<uint64_t> profiledHeapBytes{ 0 };
+inline void profileAllocation(size_t bytes) { profiledHeapBytes.fetch_add(bytes, std::memory_order_relaxed); }
+
+// The last completed frame, as 32-bit words: JS reads it in place through FrameStatsView.
+struct FrameStats {
+    uint32_t frame;         // frames completed so far
+    float frameMicros;      // wall time of the last update() call
+    float averageMicros;    // over the histogram window
+    float maxMicros;        // over the histogram window
+    float phaseMicros[ProfilePhaseCount];
+    uint32_t counters[ProfileCounterCount];
+    uint32_t histogram[FrameHistogramBuckets];
+};
+
+static_assert(sizeof(FrameStats) == (4 + ProfilePhaseCount + ProfileCounterCount + FrameHistogramBuckets) * 4,
+              "frame stats are read from JS as packed 32-bit words");
+
+// Heap location of the FrameStats; the word offsets follow the struct layout above.
+struct FrameStatsView {
+    uintptr_t ptr;
+    uint32_t phaseCount;
+    uint32_t counterCount;
+    uint32_t bucketCount;
+    bool enabled; // false when built with PLATFORMER_PROFILE=0
+};
+
+// Collects phase times and counters for the frame in progress and publishes them into a
+// FrameStats when it ends. Timed spans also go into a fixed ring for Chrome trace dumps, so
+// nothing allocates after construction. Only the thread that runs update() touches it.
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t TraceCapacity = 8192; // spans kept for the trace dump
+
+    Profiler() {
+#if PLATFORMER_PROFILE
+        trace.resize(TraceCapacity);
+        epoch = Clock::now();
+#endif
+    }
+
+    void beginFrame() {
+#if PLATFORMER_PROFILE
+        frameStart = Clock::now();
+        heapAtFrameStart = profiledHeapBytes.load(std::memory_order_relaxed);
+        for (double& t : phase) t = 0.0;
+        for (uint64_t& c : current) c = 0;
+#endif
+    }
+
+    void endFrame() {
+#if PLATFORMER_PROFILE
+        const Clock::time_point end = Clock::now();
+        current[static_cast<uint32_t>(ProfileCounter::BytesAllocated)] =
+            profiledHeapBytes.load(std::memory_order_relaxed) - heapAtFrameStart;
+        const double micros = record(FrameSpan, frameStart, end);
+
+        stats.frame = ++frames;
+        stats.frameMicros = static_cast<float>(micros);
+        for (uint32_t p = 0; p < ProfilePhaseCount; ++p) stats.phaseMicros[p] = static_cast<float>(phase[p]);
+        for (uint32_t c = 0; c < ProfileCounterCount; ++c) {
+            stats.counters[c] = static_cast<uint32_t>(current[c]);
+            totals[c] += current[c];
+        }
+        totals[static_cast<uint32_t>(ProfileCounter::ParticlesAlive)] = current[static_cast<uint32_t>(ProfileCounter::ParticlesAlive)];
+
+        // Rolling window: the oldest frame leaves the histogram (and the sum) as the new one
+        // enters. The max is only rescanned when the frame leaving was the max.
+        const uint32_t slot = static_cast<uint32_t>((frames - 1) % FrameHistogramWindow);
+        const uint32_t filled = frames < FrameHistogramWindow ? static_cast<uint32_t>(frames) : FrameHistogramWindow;
+        const float leaving = window[slot];
+        if (frames > FrameHistogramWindow) {
+            --stats.histogram[bucketOf(leaving)];
+            windowSum -= leaving;
+        }
+        window[slot] = static_cast<float>(micros);
+        ++stats.histogram[bucketOf(window[slot])];
+        windowSum += window[slot];
+        if (window[slot] >= stats.maxMicros) {
+            stats.maxMicros = window[slot];
+        } else if (leaving == stats.maxMicros) {
+            stats.maxMicros = 0.0f;
+            for (uint32_t i = 0; i < filled; ++i) stats.maxMicros = std::max(stats.maxMicros, window[i]);
+        }
+        stats.averageMicros = static_cast<float>(windowSum / filled);
+#endif
+    }
+
+    void addPhase(ProfilePhase p, Clock::time_point start, Clock::time_point end) {
+#if PLATFORMER_PROFILE
+        phase[static_cast<uint32_t>(p)] += record(static_cast<uint32_t>(p), start, end);
+#else
+        (void)p; (void)start; (void)end;
+#endif
+    }
+
+    void count(ProfileCounter c, uint64_t n = 1) {
+#if PLATFORMER_PROFILE
+        current[static_cast<uint32_t>(c)] += n;
+#else
+        (void)c; (void)n;
+#endif
+    }
+
+    void set(ProfileCounter c, uint64_t value) {
+#if PLATFORMER_PROFILE
+        current[static_cast<uint32_t>(c)] = value;
+#else
+        (void)c; (void)value;
+#endif
+    }
+
+    const FrameStats& frameStats() const { return stats; }
+
+    FrameStatsView view() const {
+        return { reinterpret_cast<uintptr_t>(&stats), ProfilePhaseCount, ProfileCounterCount, FrameHistogramBuckets,
+                 PLATFORMER_PROFILE != 0 };
+    }
+
+    // The last frame's stats plus totals over every profiled frame (particlesAlive: the
+    // current count), as one JSON object.
+    void writeJson(std::string& out) const {
+        out += "{\"frames\":" + std::to_string(stats.frame);
+        appendField(out, "frameMicros", stats.frameMicros);
+        appendField(out, "averageMicros", stats.averageMicros);
+        appendField(out, "maxMicros", stats.maxMicros);
+        out += ",\"phaseMicros\":{";
+        for (uint32_t p = 0; p < ProfilePhaseCount; ++p) {
+            if (p) out += ',';
+            appendNumber(out, profilePhaseName(static_cast<ProfilePhase>(p)), stats.phaseMicros[p]);
+        }
+        out += "},\"counters\":{";
+        for (uint32_t c = 0; c < ProfileCounterCount; ++c) {
+            if (c) out += ',';
+            out += '"';
+            out += profileCounterName(static_cast<ProfileCounter>(c));
+            out += "\":" + std::to_string(stats.counters[c]);
+        }
+        out += "},\"totals\":{";
+        for (uint32_t c = 0; c < ProfileCounterCount; ++c) {
+            if (c) out += ',';
+            out += '"';
+            out += profileCounterName(static_cast<ProfileCounter>(c));
+            out += "\":" + std::to_string(totals[c]);
+        }
+        out += "},\"histogramBucketMicros\":[";
+        for (uint32_t b = 0; b < FrameHistogramBuckets; ++b) {
+            if (b) out += ',';
+            out += std::to_string(b == 0 ? 0u : 1u << b);
+        }
+        out += "],\"histogram\":[";
+        for (uint32_t b = 0; b < FrameHistogramBuckets; ++b) {
+            if (b) out += ',';
+            out += std::to_string(stats.histogram[b]);
+        }
+        out += "]}";
+    }
+
+    // The retained spans (the most recent TraceCapacity) in Chrome's trace event format, for
+    // chrome://tracing or Perfetto. Phases nest inside their frame's "update" span.
+    void writeChromeTrace(std::string& out) const {
+        out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        const size_t retained = traced < TraceCapacity ? traced : TraceCapacity;
+        for (size_t i = 0; i < retained; ++i) {
+            const Span& s = trace[(traced - retained + i) % TraceCapacity];
+            char line[160];
+            std::snprintf(line, sizeof(line), "%s{\"name\":\"%s\",\"cat\":\"game\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                          i ? "," : "", s.kind == FrameSpan ? "update" : profilePhaseName(static_cast<ProfilePhase>(s.kind)),
+                          s.startMicros, s.durationMicros);
+            out += line;
+        }
+        out += "]}";
+    }
+
+private:
+    static constexpr uint32_t FrameSpan = ProfilePhaseCount; // Span::kind of a whole frame
+
+    struct Span {
+        uint32_t kind;        // ProfilePhase, or FrameSpan
+        float durationMicros;
+        double startMicros;   // since the profiler was created
+    };
+
+    // Appends the span to the trace ring and returns its length in microseconds.
+    double record(uint32_t kind, Clock::time_point start, Clock::time_point end) {
+        const double micros = std::chrono::duration<double, std::micro>(end - start).count();
+        trace[traced++ % TraceCapacity] = { kind, static_cast<float>(micros),
+                                            std::chrono::duration<double, std::micro>(start - epoch).count() };
+        return micros;
+    }
+
+    static uint32_t bucketOf(float micros) {
+        uint32_t b = 0;
+        while (b + 1 < FrameHistogramBuckets && micros >= static_cast<float>(2u << b)) ++b;
+        return b;
+    }
+
+    static void appendNumber(std::string& out, const char* name, double value) {
+        char text[64];
+        std::snprintf(text, sizeof(text), "\"%s\":%.3f", name, value);
+        out += text;
+    }
+
+    static void appendField(std::string& out, const char* name, double value) {
+        out += ',';
+        appendNumber(out, name, value);
+    }
+
+    FrameStats stats{};
+    uint64_t frames = 0;
+    uint64_t totals[ProfileCounterCount] = {};
+    uint64_t current[ProfileCounterCount] = {};
+    double phase[ProfilePhaseCount] = {};
+    float window[FrameHistogramWindow] = {};
+    double windowSum = 0.0;
+    uint64_t heapAtFrameStart = 0;
+    Clock::time_point epoch{};
+    Clock::time_point frameStart{};
+    std::vector<Span> trace;
+    size_t traced = 0;
+};
+
+// Adds the time until the end of the enclosing block to `phase`. Empty without PLATFORMER_PROFILE.
+class ProfileScope {
+public:
+#if PLATFORMER_PROFILE
+    ProfileScope(Profiler& profiler, ProfilePhase phase) : profiler(profiler), phase(phase), start(Profiler::Clock::now()) {}
+    ~ProfileScope() { profiler.addPhase(phase, start, Profiler::Clock::now()); }
+#else
+    ProfileScope(Profiler&, ProfilePhase) {}
+#endif
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+#if PLATFORMER_PROFILE
+private:
+    Profiler& profiler;
+    ProfilePhase phase;
+    Profiler::Clock::time_point start;
+#endif
+};
+
+// Brackets one update() call, early returns included.
+class ProfileFrame {
+public:
+    explicit ProfileFrame(Profiler& profiler) : profiler(profiler) { profiler.beginFrame(); }
+    ~ProfileFrame() { profiler.endFrame(); }
+    ProfileFrame(const ProfileFrame&) = delete;
+    ProfileFrame& operator=(const ProfileFrame&) = delete;
+
+private:
+    Profiler& profiler;
+};
+
+#endif // PROFILER_HPP
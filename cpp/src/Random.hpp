@@ -0,0 +1,40 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <cstdint>
+
+// PCG32 (XSH-RR). Tiny state, fast, and the same sequence on every platform and compiler,
+// which std::rand() does not promise -- seeded runs can be recorded and replayed bit for bit.
+class Random {
+public:
+    explicit Random(uint32_t seed = DefaultSeed) { reseed(seed); }
+
+    void reseed(uint32_t seed) {
+        state = 0;
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        const uint64_t old = state;
+        state = old * 6364136223846793005ULL + Increment;
+        const uint32_t xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        const uint32_t rot = static_cast<uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    // Value in [0, bound). Modulo bias is irrelevant at the small bounds used for effects.
+    int below(int bound) { return static_cast<int>(next() % static_cast<uint32_t>(bound)); }
+
+    uint64_t getState() const { return state; }
+    void setState(uint64_t restored) { state = restored; }
+
+    static constexpr uint32_t DefaultSeed = 0x5eed1234u;
+
+private:
+    static constexpr uint64_t Increment = 1442695040888963407ULL;
+    uint64_t state = 0;
+};
+
+#endif // RANDOM_HPP
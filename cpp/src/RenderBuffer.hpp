@@ -0,0 +1,214 @@
+#ifndef RENDER_BUFFER_HPP
+#define RENDER_BUFFER_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <numeric>
+#include "Types.hpp"
+#include "PlatformGrid.hpp"
+#include "PlatformSweep.hpp"
+#include "ParticleSystem.hpp"
+#include "ParticleBursts.hpp"
+#include "Entities.hpp"
+
+// One quad as the instanced sprite shader reads it: eight interleaved floats.
+struct SpriteInstance {
+    Vec2 position;   // centre, world units
+    Vec2 size;       // world units
+    float rotation;  // radians, counter-clockwise
+    float alpha;     // multiplies the texel alpha; particles fade out with life / maxLife
+    Vec2 frame;      // sprite-sheet cell (column, row): (0, 0) for platforms and particles,
+                     // (PlayerState, EntityKind) for entities
+};
+
+static_assert(sizeof(SpriteInstance) == 8 * sizeof(float), "instances are uploaded as eight packed floats");
+
+// The per-frame sprite groups that share a texture, in draw order. Platforms are static and
+// live in StaticSpriteLayer instead.
+enum class RenderBatch : uint32_t {
+    Entities = 0,  // every entity except the player, which JS draws from its animation state
+    Particles = 1,
+};
+
+constexpr uint32_t RenderBatchCount = 2;
+
+// Heap location of the instance buffer built by Game::buildRenderBuffer. Batch b occupies
+// instances [start[b], start[b] + count[b]); the whole buffer is `total` instances of
+// `stride` floats.
+struct RenderView {
+    uintptr_t ptr;
+    uint32_t stride;
+    uint32_t total;
+    uint32_t entityStart, entityCount;
+    uint32_t particleStart, particleCount;
+};
+
+// Heap location of the static platform sprites: `count` instances of `stride` floats, valid
+// until the geometry revision changes.
+struct StaticSpriteView {
+    uintptr_t ptr;
+    uint32_t stride;
+    uint32_t count;
+    uint32_t revision;
+};
+
+// A contiguous run of instances.
+struct SpriteRange {
+    uint32_t start;
+    uint32_t count;
+};
+
+// Platform sprites packed once per geometry revision, grouped by width class (see
+// widthClasses) and sorted by left edge within each (ties keep platform order), so the
+// sprites of a class overlapping any horizontal window form one contiguous run. Hosts
+// upload the whole layer when the revision changes and then only pick the runs per frame.
+class StaticSpriteLayer {
+public:
+    void build(const std::vector<Platform>& platforms, uint32_t geometryRevision) {
+        const uint32_t classes = widthClasses(platforms, widthClass);
+        order.resize(platforms.size());
+        std::iota(order.begin(), order.end(), 0u);
+        auto leftOf = [&platforms](uint32_t i) { return platforms[i].position.x - platforms[i].size.x / 2.0f; };
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            if (widthClass[a] != widthClass[b]) return widthClass[a] < widthClass[b];
+            return leftOf(a) < leftOf(b);
+        });
+        instances.clear();
+        left.clear();
+        classStart.assign(classes + 1, static_cast<uint32_t>(platforms.size()));
+        classWidest.assign(classes, 0.0f);
+        for (uint32_t s = 0; s < order.size(); ++s) {
+            const uint32_t i = order[s];
+            const Platform& p = platforms[i];
+            instances.push_back({ p.position, p.size, 0.0f, 1.0f, { 0.0f, 0.0f } });
+            left.push_back(leftOf(i));
+            const uint32_t c = widthClass[i];
+            classStart[c] = std::min(classStart[c], s);
+            classWidest[c] = std::max(classWidest[c], p.size.x);
+        }
+        for (uint32_t c = classes; c-- > 0;) classStart[c] = std::min(classStart[c], classStart[c + 1]); // empty classes
+        builtRevision = geometryRevision;
+    }
+
+    // Every sprite overlapping (minX, maxX) horizontally is in one of the runs appended to
+    // `runs` (at most one per width class, narrowest first), along with some that only come
+    // close: each class reaches back by its own widest sprite, at most twice any other's width.
+    void ranges(float minX, float maxX, std::vector<SpriteRange>& runs) const {
+        runs.clear();
+        for (uint32_t c = 0; c + 1 < classStart.size(); ++c) {
+            const auto begin = left.begin() + classStart[c];
+            const auto end = left.begin() + classStart[c + 1];
+            const auto first = std::upper_bound(begin, end, minX - classWidest[c]);
+            const auto last = std::lower_bound(first, end, maxX);
+            if (last != first) runs.push_back({ static_cast<uint32_t>(first - left.begin()), static_cast<uint32_t>(last - first) });
+        }
+    }
+
+    StaticSpriteView view() const {
+        return { reinterpret_cast<uintptr_t>(instances.data()), static_cast<uint32_t>(sizeof(SpriteInstance) / sizeof(float)),
+                 static_cast<uint32_t>(instances.size()), builtRevision };
+    }
+
+    const std::vector<SpriteInstance>& data() const { return instances; }
+    uint32_t platformIndex(uint32_t sprite) const { return order[sprite]; } // sprite slot -> platform index
+    uint32_t revision() const { return builtRevision; }
+    uint32_t classCount() const { return static_cast<uint32_t>(classWidest.size()); } // the most runs ranges() returns
+    SpriteRange classRange(uint32_t c) const { return { classStart[c], classStart[c + 1] - classStart[c] }; }
+
+private:
+    std::vector<SpriteInstance> instances;
+    std::vector<float> left;           // left edge per sprite, ascending within each class
+    std::vector<uint32_t> order;       // platform index per sprite
+    std::vector<uint32_t> widthClass;  // width class per platform, kept for its capacity
+    std::vector<uint32_t> classStart;  // first sprite of each class, then the sprite count
+    std::vector<float> classWidest;    // widest sprite of each class
+    uint32_t builtRevision = 0;
+};
+
+// Per-frame instance buffer, culled to the camera. Storage is kept between frames, so it only
+// reallocates when more sprites are visible than ever before.
+class RenderBuffer {
+public:
+    // Clears the buffer, first growing it to hold `maxSprites` (every sprite that could be
+    // visible) so filling it never reallocates mid-frame. Growth at least doubles, so a count
+    // that creeps up (live burst particles) settles after a few frames.
+    void begin(size_t maxSprites = 0) {
+        if (instances.capacity() < maxSprites) instances.reserve(std::max(maxSprites, 2 * instances.capacity()));
+        instances.clear();
+        for (uint32_t b = 0; b < RenderBatchCount; ++b) start[b] = count[b] = 0;
+    }
+
+    void addEntities(const EntityStore& entities, const Aabb& view) {
+        open(RenderBatch::Entities);
+        for (uint32_t i = PlayerEntity + 1; i < entities.size(); ++i) {
+            const Vec2 position = entities.position(i);
+            const Vec2 size = entities.size(i);
+            if (!overlaps(PlatformGrid::boxOf(position, size), view)) continue;
+            instances.push_back({ position, size, 0.0f, 1.0f, { static_cast<float>(entities.state[i]), static_cast<float>(entities.kind[i]) } });
+        }
+        close(RenderBatch::Entities);
+    }
+
+    // Particles are square; the bounding circle of the rotated quad is used for culling.
+    void addParticles(const ParticleSystem& particles, const Aabb& view) {
+        open(RenderBatch::Particles);
+        const ParticleArrays& p = particles.arrays();
+        for (size_t i = 0; i < particles.size(); ++i) {
+            const float reach = p.size[i] * 0.7072f; // > sqrt(2) / 2
+            if (p.positionX[i] + reach <= view.min.x || p.positionX[i] - reach >= view.max.x ||
+                p.positionY[i] + reach <= view.min.y || p.positionY[i] - reach >= view.max.y) continue;
+            const float alpha = p.maxLife[i] > 0.0f ? p.life[i] / p.maxLife[i] : 0.0f;
+            instances.push_back({ { p.positionX[i], p.positionY[i] }, { p.size[i], p.size[i] }, p.rotation[i], alpha, { 0.0f, 0.0f } });
+        }
+        close(RenderBatch::Particles);
+    }
+
+    // Expands the bursts whose bounds reach the view into the particle batch; call right after
+    // addParticles. Each particle is then culled exactly as addParticles culls a pooled one.
+    void addBursts(const BurstSystem& bursts, const Aabb& view) {
+        for (const ParticleBurst& b : bursts.data()) {
+            const float age = bursts.ageOf(b);
+            const float reach = b.size * 0.7072f;
+            const Aabb centres = BurstSystem::boundsOf(b, age);
+            if (centres.max.x + reach <= view.min.x || centres.min.x - reach >= view.max.x ||
+                centres.max.y + reach <= view.min.y || centres.min.y - reach >= view.max.y) continue;
+            for (uint32_t k = 0; k < b.count; ++k) {
+                const BurstParticle p = BurstSystem::particleAt(b, k, age);
+                if (p.position.x + reach <= view.min.x || p.position.x - reach >= view.max.x ||
+                    p.position.y + reach <= view.min.y || p.position.y - reach >= view.max.y) continue;
+                instances.push_back({ p.position, { b.size, b.size }, p.rotation, p.alpha, { 0.0f, 0.0f } });
+            }
+        }
+        close(RenderBatch::Particles);
+    }
+
+    RenderView view() const {
+        return { reinterpret_cast<uintptr_t>(instances.data()), static_cast<uint32_t>(sizeof(SpriteInstance) / sizeof(float)),
+                 static_cast<uint32_t>(instances.size()),
+                 start[0], count[0], start[1], count[1] };
+    }
+
+    const std::vector<SpriteInstance>& data() const { return instances; }
+    uint32_t batchStart(RenderBatch batch) const { return start[static_cast<uint32_t>(batch)]; }
+    uint32_t batchCount(RenderBatch batch) const { return count[static_cast<uint32_t>(batch)]; }
+
+    // Same strict test as checkCollision: boxes that only touch the view edge are culled.
+    static bool overlaps(const Aabb& a, const Aabb& b) {
+        return a.min.x < b.max.x && a.max.x > b.min.x && a.min.y < b.max.y && a.max.y > b.min.y;
+    }
+
+private:
+    void open(RenderBatch batch) { start[static_cast<uint32_t>(batch)] = static_cast<uint32_t>(instances.size()); }
+    void close(RenderBatch batch) {
+        const uint32_t b = static_cast<uint32_t>(batch);
+        count[b] = static_cast<uint32_t>(instances.size()) - start[b];
+    }
+
+    std::vector<SpriteInstance> instances;
+    uint32_t start[RenderBatchCount] = {};
+    uint32_t count[RenderBatchCount] = {};
+};
+
+#endif // RENDER_BUFFER_HPP
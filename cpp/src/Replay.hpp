@@ -0,0 +1,152 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include "Types.hpp"
+
+// Recorded session layout (little-endian):
+//
+//   offset  0  char[4]  magic "WPRP"
+//           4  uint32   version (ReplayFormatVersion)
+//           8  uint32   RNG seed the session started from
+//          12  uint32   frame count F
+//          16  uint32   checksum interval N (0 = no checksums)
+//          20  uint32   checksum count C
+//          24  uint32   frame byte count B
+//          28  uint8[B] frames, then uint32[C] state checksums taken after every Nth frame
+//
+// Each frame is one flags byte -- bits 0-2 left/right/jump, bit 3 "handleInput was called
+// this frame", bit 4 "deltaTime changed" -- followed by a float32 deltaTime only when bit 4
+// is set. A steady 60 Hz session costs one byte per frame.
+
+constexpr uint32_t ReplayFormatVersion = 1;
+constexpr size_t ReplayHeaderSize = 28;
+
+struct ReplayFrame {
+    InputState input{ false, false, false };
+    bool hasInput = false; // handleInput was called before this frame's update
+    float deltaTime = 0.0f;
+};
+
+class ReplayRecorder {
+public:
+    void begin(uint32_t rngSeed, uint32_t interval) {
+        seed = rngSeed;
+        checksumInterval = interval;
+        frameCount = 0;
+        lastDeltaTime = 0.0f;
+        frames.clear();
+        checksums.clear();
+    }
+
+    void addFrame(const ReplayFrame& frame) {
+        uint8_t flags = (frame.input.left ? 1u : 0u) | (frame.input.right ? 2u : 0u) | (frame.input.jump ? 4u : 0u) |
+                        (frame.hasInput ? 8u : 0u);
+        const bool newDeltaTime = frameCount == 0 || std::memcmp(&frame.deltaTime, &lastDeltaTime, sizeof(float)) != 0;
+        if (newDeltaTime) flags |= 16u;
+        frames.push_back(flags);
+        if (newDeltaTime) {
+            uint8_t bytes[sizeof(float)];
+            std::memcpy(bytes, &frame.deltaTime, sizeof(float));
+            frames.insert(frames.end(), bytes, bytes + sizeof(float));
+            lastDeltaTime = frame.deltaTime;
+        }
+        ++frameCount;
+    }
+
+    void addChecksum(uint32_t checksum) { checksums.push_back(checksum); }
+
+    void encode(std::vector<uint8_t>& out) const {
+        out.resize(ReplayHeaderSize + frames.size() + checksums.size() * sizeof(uint32_t));
+        const uint32_t header[6] = { ReplayFormatVersion, seed, frameCount, checksumInterval,
+                                     static_cast<uint32_t>(checksums.size()), static_cast<uint32_t>(frames.size()) };
+        std::memcpy(out.data(), "WPRP", 4);
+        std::memcpy(out.data() + 4, header, sizeof(header));
+        if (!frames.empty()) std::memcpy(out.data() + ReplayHeaderSize, frames.data(), frames.size());
+        if (!checksums.empty()) {
+            std::memcpy(out.data() + ReplayHeaderSize + frames.size(), checksums.data(), checksums.size() * sizeof(uint32_t));
+        }
+    }
+
+    uint32_t interval() const { return checksumInterval; }
+
+private:
+    uint32_t seed = 0;
+    uint32_t checksumInterval = 0;
+    uint32_t frameCount = 0;
+    float lastDeltaTime = 0.0f;
+    std::vector<uint8_t> frames;
+    std::vector<uint32_t> checksums;
+};
+
+// Walks an encoded session. The buffer must outlive the reader.
+class ReplayReader {
+public:
+    // Returns false if the buffer is truncated or not a replay of this version.
+    bool open(const uint8_t* data, size_t length) {
+        frameBytes = nullptr;
+        if (data == nullptr || length < ReplayHeaderSize || std::memcmp(data, "WPRP", 4) != 0) return false;
+        uint32_t header[6];
+        std::memcpy(header, data + 4, sizeof(header));
+        if (header[0] != ReplayFormatVersion) return false;
+        const uint64_t needed = ReplayHeaderSize + static_cast<uint64_t>(header[5]) + static_cast<uint64_t>(header[4]) * sizeof(uint32_t);
+        if (needed > length) return false;
+        seed = header[1];
+        frameCount = header[2];
+        checksumInterval = header[3];
+        checksumCount = header[4];
+        frameBytesLength = header[5];
+        frameBytes = data + ReplayHeaderSize;
+        checksumBytes = frameBytes + frameBytesLength;
+        cursor = 0;
+        framesRead = 0;
+        deltaTime = 0.0f;
+        return true;
+    }
+
+    // Decodes the next frame; false at the end of the session (or on corrupt frame data).
+    bool next(ReplayFrame& frame) {
+        if (frameBytes == nullptr || framesRead >= frameCount || cursor >= frameBytesLength) return false;
+        const uint8_t flags = frameBytes[cursor++];
+        if (flags & 16u) {
+            if (cursor + sizeof(float) > frameBytesLength) return false;
+            std::memcpy(&deltaTime, frameBytes + cursor, sizeof(float));
+            cursor += sizeof(float);
+        }
+        frame.input = { (flags & 1u) != 0, (flags & 2u) != 0, (flags & 4u) != 0 };
+        frame.hasInput = (flags & 8u) != 0;
+        frame.deltaTime = deltaTime;
+        ++framesRead;
+        return true;
+    }
+
+    // Checksum recorded after frame `frame` (1-based), if one was taken there.
+    bool expectedChecksum(uint32_t frame, uint32_t& checksum) const {
+        if (checksumInterval == 0 || frame % checksumInterval != 0) return false;
+        const uint32_t index = frame / checksumInterval - 1;
+        if (index >= checksumCount) return false;
+        std::memcpy(&checksum, checksumBytes + index * sizeof(uint32_t), sizeof(uint32_t));
+        return true;
+    }
+
+    uint32_t rngSeed() const { return seed; }
+    uint32_t interval() const { return checksumInterval; }
+    uint32_t totalFrames() const { return frameCount; }
+    uint32_t position() const { return framesRead; }
+
+private:
+    const uint8_t* frameBytes = nullptr;
+    const uint8_t* checksumBytes = nullptr;
+    uint32_t seed = 0;
+    uint32_t frameCount = 0;
+    uint32_t checksumInterval = 0;
+    uint32_t checksumCount = 0;
+    uint32_t frameBytesLength = 0;
+    uint32_t cursor = 0;
+    uint32_t framesRead = 0;
+    float deltaTime = 0.0f;
+};
+
+#endif // REPLAY_HPP
@@ -0,0 +1,101 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// Saved simulation state layout (little-endian), written by Game::saveState:
+//
+//   offset  0  char[4]  magic "WPSS"
+//           4  uint32   version (SnapshotFormatVersion)
+//           8  uint32   total byte length
+//          12  uint32   identity of the level the state was taken on (levelIdentity)
+//          16  uint32   triggered goal count G
+//          20  uint32   entity count E
+//          24  uint32   particle count P
+//          28  uint32   burst count B
+//          32  ...      fixed-size block of scalars (camera, timers, burst clock, player flags,
+//                       RNG state), then each entity component array (E elements, EntityStore
+//                       order), each particle field (P floats), B ParticleBursts and the
+//                       positions of the G triggered goals (Vec2 each)
+//
+// Level geometry is not copied: a snapshot only restores onto the level it was taken on, and
+// names goals by position, so it still applies after a chunked level has streamed chunks in
+// or out. Arrays are raw in-memory copies, so saving and restoring are a handful of memcpys.
+
+constexpr uint32_t SnapshotFormatVersion = 4; // 2: bursts, 3: moving platform paths, 4: level identity
+constexpr size_t SnapshotHeaderSize = 32;
+
+struct SnapshotHeader {
+    uint32_t version;
+    uint32_t length;
+    uint32_t level;
+    uint32_t goalCount; // triggered goals only
+    uint32_t entityCount;
+    uint32_t particleCount;
+    uint32_t burstCount;
+};
+
+static_assert(sizeof(SnapshotHeader) == SnapshotHeaderSize - 4, "header follows the magic with no padding");
+
+// Appends raw values to a buffer. Reuses the buffer's capacity, so saving into the same
+// vector every frame stops allocating once it has held the largest state.
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::vector<uint8_t>& buffer) : out(buffer) { out.clear(); }
+
+    template <typename T>
+    void value(const T& v) { bytes(&v, sizeof(T)); }
+
+    template <typename T>
+    void array(const std::vector<T>& v, size_t count) { bytes(v.data(), count * sizeof(T)); }
+
+    void bytes(const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        out.insert(out.end(), p, p + size);
+    }
+
+private:
+    std::vector<uint8_t>& out;
+};
+
+// Reads values back in the order they were written. Unchecked: the caller validates the
+// total length against the header counts first.
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const uint8_t* data) : cursor(data) {}
+
+    template <typename T>
+    void value(T& v) { bytes(&v, sizeof(T)); }
+
+    // Fills the first `count` elements of v, which must already hold that many.
+    template <typename T>
+    void array(std::vector<T>& v, size_t count) { bytes(v.data(), count * sizeof(T)); }
+
+    void bytes(void* data, size_t size) {
+        if (size) std::memcpy(data, cursor, size);
+        cursor += size;
+    }
+
+    // Steps over `size` bytes and returns where they start, for data copied by its owner.
+    const uint8_t* skip(size_t size) {
+        const uint8_t* start = cursor;
+        cursor += size;
+        return start;
+    }
+
+private:
+    const uint8_t* cursor;
+};
+
+// Checks the magic and version and reads the header; false if the buffer is not a snapshot
+// of this version or its length does not match.
+inline bool readSnapshotHeader(const uint8_t* data, size_t length, SnapshotHeader& header) {
+    if (data == nullptr || length < SnapshotHeaderSize || std::memcmp(data, "WPSS", 4) != 0) return false;
+    std::memcpy(&header, data + 4, sizeof(header));
+    return header.version == SnapshotFormatVersion && header.length == length;
+}
+
+#endif // SNAPSHOT_HPP
@@ -1,13 +1,36 @@
 #ifndef TYPES_HPP
 #define TYPES_HPP
 
-#include <string>
 #include <vector>
+#include <cstdint>
 
 struct Vec2 { float x; float y; };
 
 struct Platform { Vec2 position; Vec2 size; };
 
+struct Aabb { Vec2 min; Vec2 max; };
+
+// A packed float array in linear memory that JS can wrap as a Float32Array view over
+// the module heap instead of marshaling element by element.
+struct BufferView {
+    uintptr_t ptr;   // byte address in the heap
+    uint32_t count;  // number of elements
+    uint32_t stride; // floats per element
+};
+
+// Heap addresses of the particle pool's per-field float arrays. Each array is `capacity`
+// floats long and the first `count` entries are live.
+struct ParticleView {
+    uint32_t count;
+    uint32_t capacity;
+    uintptr_t positionX;
+    uintptr_t positionY;
+    uintptr_t life;
+    uintptr_t maxLife;
+    uintptr_t size;
+    uintptr_t rotation;
+};
+
 struct InputState { bool left; bool right; bool jump; };
 
 enum class PlayerState {
@@ -17,8 +40,27 @@ enum class PlayerState {
     Fall
 };
 
+// Player animation clips. JS reads the names once (animationName) to map ids to sprite-sheet
+// rows, so the per-frame state carries no strings.
+enum class AnimationId : uint32_t {
+    Idle = 0,
+    Run = 1,
+    Jump = 2, // also used while falling
+};
+
+constexpr uint32_t AnimationCount = 3;
+
+inline const char* animationName(AnimationId id) {
+    switch (id) {
+        case AnimationId::Idle: return "idle";
+        case AnimationId::Run: return "run";
+        case AnimationId::Jump: return "jump";
+    }
+    return "";
+}
+
 struct AnimationState {
-    std::string currentState;
+    uint32_t animation; // AnimationId
     int currentFrame;
     bool facingLeft;
 };
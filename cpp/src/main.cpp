@@ -1,6 +1,7 @@
 #include "Game.hpp"
 #include "ParticleSystem.hpp"
 #include <emscripten/bind.h>
+#include <cstddef>
 
 EMSCRIPTEN_BINDINGS(WASM_Venture) {
     emscripten::value_object<Vec2>("Vec2")
@@ -19,32 +20,194 @@ EMSCRIPTEN_BINDINGS(WASM_Venture) {
         .field("jump", &InputState::jump);
 
     emscripten::value_object<AnimationState>("AnimationState")
-        .field("currentState", &AnimationState::currentState)
+        .field("animation", &AnimationState::animation)
         .field("currentFrame", &AnimationState::currentFrame)
         .field("facingLeft", &AnimationState::facingLeft);
 
-    emscripten::value_object<Particle>("Particle")
-        .field("position", &Particle::position)
-        .field("velocity", &Particle::velocity)
-        .field("life", &Particle::life)
-        .field("maxLife", &Particle::maxLife)
-        .field("size", &Particle::size)
-        .field("rotation", &Particle::rotation)
-        .field("angularVelocity", &Particle::angularVelocity);
+    emscripten::value_object<BufferView>("BufferView")
+        .field("ptr", &BufferView::ptr)
+        .field("count", &BufferView::count)
+        .field("stride", &BufferView::stride);
 
-    emscripten::register_vector<Particle>("ParticleList");
+    emscripten::value_object<ParticleView>("ParticleView")
+        .field("count", &ParticleView::count)
+        .field("capacity", &ParticleView::capacity)
+        .field("positionX", &ParticleView::positionX)
+        .field("positionY", &ParticleView::positionY)
+        .field("life", &ParticleView::life)
+        .field("maxLife", &ParticleView::maxLife)
+        .field("size", &ParticleView::size)
+        .field("rotation", &ParticleView::rotation);
+
+    emscripten::value_object<EventView>("EventView")
+        .field("ptr", &EventView::ptr)
+        .field("capacity", &EventView::capacity)
+        .field("start", &EventView::start)
+        .field("count", &EventView::count)
+        .field("dropped", &EventView::dropped);
+
+    emscripten::value_object<EntityView>("EntityView")
+        .field("count", &EntityView::count)
+        .field("positionX", &EntityView::positionX)
+        .field("positionY", &EntityView::positionY)
+        .field("sizeX", &EntityView::sizeX)
+        .field("sizeY", &EntityView::sizeY)
+        .field("kind", &EntityView::kind)
+        .field("state", &EntityView::state);
+
+    emscripten::value_object<RenderView>("RenderView")
+        .field("ptr", &RenderView::ptr)
+        .field("stride", &RenderView::stride)
+        .field("total", &RenderView::total)
+        .field("entityStart", &RenderView::entityStart)
+        .field("entityCount", &RenderView::entityCount)
+        .field("particleStart", &RenderView::particleStart)
+        .field("particleCount", &RenderView::particleCount);
+
+    emscripten::value_object<StaticSpriteView>("StaticSpriteView")
+        .field("ptr", &StaticSpriteView::ptr)
+        .field("stride", &StaticSpriteView::stride)
+        .field("count", &StaticSpriteView::count)
+        .field("revision", &StaticSpriteView::revision);
+
+    emscripten::value_object<SpriteRange>("SpriteRange")
+        .field("start", &SpriteRange::start)
+        .field("count", &SpriteRange::count);
+
+    emscripten::value_object<RayHit>("RayHit")
+        .field("hit", &RayHit::hit)
+        .field("platform", &RayHit::platform)
+        .field("distance", &RayHit::distance)
+        .field("point", &RayHit::point)
+        .field("normal", &RayHit::normal);
+
+    emscripten::value_object<FrameStatsView>("FrameStatsView")
+        .field("ptr", &FrameStatsView::ptr)
+        .field("phaseCount", &FrameStatsView::phaseCount)
+        .field("counterCount", &FrameStatsView::counterCount)
+        .field("bucketCount", &FrameStatsView::bucketCount)
+        .field("enabled", &FrameStatsView::enabled);
+
+    emscripten::value_object<PhysicsTuning>("PhysicsTuning")
+        .field("gravity", &PhysicsTuning::gravity)
+        .field("moveSpeed", &PhysicsTuning::moveSpeed)
+        .field("jumpStrength", &PhysicsTuning::jumpStrength)
+        .field("enemySpeed", &PhysicsTuning::enemySpeed)
+        .field("groundCheckDistance", &PhysicsTuning::groundCheckDistance)
+        .field("jumpParticles", &PhysicsTuning::jumpParticles)
+        .field("landParticles", &PhysicsTuning::landParticles)
+        .field("runParticleChance", &PhysicsTuning::runParticleChance)
+        .field("frameDuration", &PhysicsTuning::frameDuration);
+
+    emscripten::enum_<PhysicsProfile>("PhysicsProfile")
+        .value("Standard", PhysicsProfile::Standard)
+        .value("LowFx", PhysicsProfile::LowFx)
+        .value("HighFx", PhysicsProfile::HighFx)
+        .value("Custom", PhysicsProfile::Custom);
+
+    emscripten::enum_<EntityKind>("EntityKind")
+        .value("Player", EntityKind::Player)
+        .value("Enemy", EntityKind::Enemy)
+        .value("Collectible", EntityKind::Collectible)
+        .value("MovingPlatform", EntityKind::MovingPlatform);
+
+    // Event record words: [type, code, x, y]
+    emscripten::constant("EVENT_SOUND", static_cast<uint32_t>(EventType::Sound));
+    emscripten::constant("EVENT_GOAL_REACHED", static_cast<uint32_t>(EventType::GoalReached));
+    emscripten::constant("EVENT_STATE_CHANGED", static_cast<uint32_t>(EventType::StateChanged));
+    emscripten::constant("EVENT_COLLECTED", static_cast<uint32_t>(EventType::Collected));
+    emscripten::constant("SOUND_JUMP", static_cast<uint32_t>(SoundId::Jump));
+    emscripten::constant("SOUND_LAND", static_cast<uint32_t>(SoundId::Land));
+    emscripten::constant("SOUND_COUNT", SoundCount);
+    emscripten::function("soundName", +[](uint32_t sound) { return std::string(soundName(static_cast<SoundId>(sound))); });
+
+    // AnimationState.animation ids and their names (read once at startup).
+    emscripten::constant("ANIMATION_COUNT", AnimationCount);
+    emscripten::function("animationName", +[](uint32_t animation) {
+        return std::string(animationName(static_cast<AnimationId>(animation)));
+    });
+
+    // Float offsets of each field inside a SpriteInstance.
+    emscripten::constant("INSTANCE_POSITION", static_cast<uint32_t>(offsetof(SpriteInstance, position) / sizeof(float)));
+    emscripten::constant("INSTANCE_SIZE", static_cast<uint32_t>(offsetof(SpriteInstance, size) / sizeof(float)));
+    emscripten::constant("INSTANCE_ROTATION", static_cast<uint32_t>(offsetof(SpriteInstance, rotation) / sizeof(float)));
+    emscripten::constant("INSTANCE_ALPHA", static_cast<uint32_t>(offsetof(SpriteInstance, alpha) / sizeof(float)));
+    emscripten::constant("INSTANCE_FRAME", static_cast<uint32_t>(offsetof(SpriteInstance, frame) / sizeof(float)));
+
+    // Word offsets of the arrays inside FrameStats, and the names of their entries.
+    emscripten::constant("FRAME_STATS_PHASE_MICROS", static_cast<uint32_t>(offsetof(FrameStats, phaseMicros) / 4));
+    emscripten::constant("FRAME_STATS_COUNTERS", static_cast<uint32_t>(offsetof(FrameStats, counters) / 4));
+    emscripten::constant("FRAME_STATS_HISTOGRAM", static_cast<uint32_t>(offsetof(FrameStats, histogram) / 4));
+    emscripten::function("profilePhaseName", +[](uint32_t phase) {
+        return std::string(profilePhaseName(static_cast<ProfilePhase>(phase)));
+    });
+    emscripten::function("profileCounterName", +[](uint32_t counter) {
+        return std::string(profileCounterName(static_cast<ProfileCounter>(counter)));
+    });
+
+    // Float offsets of each field inside a platform BufferView element.
+    emscripten::constant("PLATFORM_POSITION", static_cast<uint32_t>(offsetof(Platform, position) / sizeof(float)));
+    emscripten::constant("PLATFORM_SIZE", static_cast<uint32_t>(offsetof(Platform, size) / sizeof(float)));
 
     emscripten::class_<Game>("Game")
         .constructor<>()
         .function("update", &Game::update)
         .function("handleInput", &Game::handleInput)
+        .function("setFixedTimestep", &Game::setFixedTimestep)
+        .function("setPhysicsProfile", &Game::setPhysicsProfile)
+        .function("getPhysicsProfile", &Game::getPhysicsProfile)
+        .function("setPhysicsTuning", &Game::setPhysicsTuning)
+        .function("getPhysicsTuning", &Game::getPhysicsTuning)
         .function("getPlayerPosition", &Game::getPlayerPosition)
         .function("getCameraPosition", &Game::getCameraPosition)
+        .function("getPreviousPlayerPosition", &Game::getPreviousPlayerPosition)
+        .function("getPreviousCameraPosition", &Game::getPreviousCameraPosition)
+        .function("getInterpolationAlpha", &Game::getInterpolationAlpha)
         .function("getPlatforms", &Game::getPlatforms)
-        .function("getParticles", &Game::getParticles)
+        .function("getPlatformView", &Game::getPlatformView)
+        .function("getParticleView", &Game::getParticleView)
+        .function("getParticleCount", &Game::getParticleCount)
+        .function("getBurstCount", &Game::getBurstCount)
+        .function("getBurstParticleCount", &Game::getBurstParticleCount)
+        .function("getPlatformRevision", &Game::getPlatformRevision)
+        .function("hasGeometryChanged", &Game::hasGeometryChanged)
+        .function("getStaticSpriteView", &Game::getStaticSpriteView)
+        .function("findStaticSpriteRanges", &Game::findStaticSpriteRanges)
+        .function("getStaticSpriteRange", &Game::getStaticSpriteRange)
+        .function("buildRenderBuffer", &Game::buildRenderBuffer)
+        .function("raycast", &Game::raycast)
+        .function("findGroundBelow", &Game::findGroundBelow)
+        .function("spawnEntity", &Game::spawnEntity)
+        .function("spawnMovingPlatform", &Game::spawnMovingPlatform)
+        .function("getEntityCount", &Game::getEntityCount)
+        .function("getEntityView", &Game::getEntityView)
+        .function("setThreadCount", &Game::setThreadCount)
+        .function("getThreadCount", &Game::getThreadCount)
         .function("getPlayerAnimationState", &Game::getPlayerAnimationState)
         .function("getPlayerSize", &Game::getPlayerSize)
         .function("setSoundCallback", &Game::setSoundCallback)
         .function("loadLevel", &Game::loadLevel)
+        .function("loadLevelBinary", &Game::loadLevelBinaryFromHeap)
+        .function("loadGeneratedLevel", &Game::loadGeneratedLevel)
+        .function("setChunkRadius", &Game::setChunkRadius)
+        .function("getRequestedChunkCount", &Game::getRequestedChunkCount)
+        .function("getRequestedChunk", &Game::getRequestedChunk)
+        .function("loadChunkBinary", &Game::loadChunkBinaryFromHeap)
+        .function("setSeed", &Game::setSeed)
+        .function("startRecording", &Game::startRecording)
+        .function("stopRecording", &Game::stopRecording)
+        .function("getRecordingData", &Game::getRecordingData)
+        .function("getRecordingSize", &Game::getRecordingSize)
+        .function("startReplay", &Game::startReplayFromHeap)
+        .function("runReplay", &Game::runReplay)
+        .function("isReplaying", &Game::isReplaying)
+        .function("getReplayDivergence", &Game::getReplayDivergence)
+        .function("saveState", &Game::saveStateToBuffer)
+        .function("getStateData", &Game::getStateData)
+        .function("restoreState", &Game::restoreStateFromHeap)
+        .function("getStateChecksum", &Game::getStateChecksum)
+        .function("drainEvents", &Game::drainEvents)
+        .function("getFrameStatsView", &Game::getFrameStatsView)
+        .function("getProfileJson", &Game::getProfileJson)
         .function("setLevelCompleteCallback", &Game::setLevelCompleteCallback);
 }
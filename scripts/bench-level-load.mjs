@@ -0,0 +1,67 @@
+// Level load benchmark: JSON text -> JSON.parse -> Game.loadLevel versus binary bytes ->
+// heap copy -> Game.loadLevelBinary, at 1k/10k/100k platforms. Checks that both loaders
+// produce the same platform records before timing.
+//
+// Run after `npm run build:wasm`: node scripts/bench-level-load.mjs
+import createWasmModule from '../src/wasm/main.js';
+import { encodeLevel } from './level-binary.mjs';
+
+const makeLevel = (count) => {
+  let seed = 12345;
+  const unit = () => ((seed = (seed * 1664525 + 1013904223) >>> 0) >>> 8) / 16777216;
+  const platforms = [];
+  for (let i = 0; i < count; ++i) {
+    platforms.push({ position: { x: i * 1.5 + unit(), y: unit() * 8 - 4 }, size: { x: 0.5 + unit() * 2, y: 0.2 } });
+  }
+  return {
+    spawn: { x: 0, y: 5 },
+    bounds: { min: { x: -10, y: -10 }, max: { x: count * 1.5 + 10, y: 10 } },
+    platforms,
+    goals: [{ position: { x: count * 1.5, y: 5 }, size: { x: 1, y: 1 } }],
+  };
+};
+
+const loadBinary = (module, game, bytes) => {
+  const ptr = module._malloc(bytes.length);
+  module.HEAPU8.set(bytes, ptr);
+  const ok = game.loadLevelBinary(ptr, bytes.length);
+  module._free(ptr);
+  return ok;
+};
+
+const platformBytes = (module, game) => {
+  const view = game.getPlatformView();
+  return module.HEAPU8.slice(view.ptr, view.ptr + view.count * view.stride * 4);
+};
+
+const time = (runs, fn) => {
+  fn(); // warm-up
+  const start = performance.now();
+  for (let i = 0; i < runs; ++i) fn();
+  return (performance.now() - start) / runs;
+};
+
+const module = await createWasmModule();
+const game = new module.Game();
+console.log(`${'platforms'.padStart(10)} ${'json ms'.padStart(10)} ${'binary ms'.padStart(10)} ${'json KB'.padStart(10)} ${'binary KB'.padStart(10)}`);
+for (const count of [1000, 10000, 100000]) {
+  const level = makeLevel(count);
+  const text = JSON.stringify(level);
+  const bytes = encodeLevel(level);
+
+  game.loadLevel(JSON.parse(text));
+  const fromJson = platformBytes(module, game);
+  if (!loadBinary(module, game, bytes)) throw new Error(`binary level rejected at ${count} platforms`);
+  const fromBinary = platformBytes(module, game);
+  if (fromJson.length !== fromBinary.length || fromJson.some((b, i) => b !== fromBinary[i])) {
+    console.error(`loaders disagree at ${count} platforms`);
+    process.exit(1);
+  }
+
+  const runs = Math.max(3, Math.floor(200000 / count));
+  const jsonMs = time(runs, () => game.loadLevel(JSON.parse(text)));
+  const binaryMs = time(runs, () => loadBinary(module, game, bytes));
+  console.log(`${String(count).padStart(10)} ${jsonMs.toFixed(2).padStart(10)} ${binaryMs.toFixed(2).padStart(10)} ` +
+              `${(text.length / 1024).toFixed(0).padStart(10)} ${(bytes.length / 1024).toFixed(0).padStart(10)}`);
+}
+game.delete();
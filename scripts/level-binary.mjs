@@ -0,0 +1,125 @@
+// Converts JSON levels (public/levels/*.json) into the binary layout described in
+// cpp/src/LevelFormat.hpp. Entries the JSON loader would skip are skipped here too, so
+// both loaders produce the same level.
+//
+// With --chunk-width W the level is split for streaming (see cpp/src/ChunkedWorld.hpp):
+// name.bin holds only the header, and name.chunk<k>.bin holds the platforms and goals that
+// touch [k * W, (k + 1) * W). Chunks with nothing in them are not written.
+//
+// Usage: node scripts/level-binary.mjs [--chunk-width W] [file.json | directory ...]
+//        (default: public/levels)
+import { readFileSync, writeFileSync, readdirSync, statSync } from 'node:fs';
+import { join } from 'node:path';
+import { fileURLToPath } from 'node:url';
+
+export const LEVEL_FORMAT_VERSION = 1;
+const HAS_SPAWN = 1 << 0;
+const HAS_BOUNDS = 1 << 1;
+const HEADER_BYTES = 48;
+
+const isVec2 = (v) => v != null && typeof v === 'object' && 'x' in v && 'y' in v;
+const isRecord = (r) => r != null && isVec2(r.position) && isVec2(r.size);
+
+const writeBinary = ({ spawn, bounds, platforms, goals, chunkWidth }) => {
+  const bytes = new Uint8Array(HEADER_BYTES + (platforms.length + goals.length) * 16);
+  const view = new DataView(bytes.buffer);
+  bytes.set([0x57, 0x50, 0x4c, 0x56]); // "WPLV"
+  view.setUint32(4, LEVEL_FORMAT_VERSION, true);
+  view.setUint32(8, (spawn ? HAS_SPAWN : 0) | (bounds ? HAS_BOUNDS : 0), true);
+  view.setUint32(12, platforms.length, true);
+  view.setUint32(16, goals.length, true);
+  view.setFloat32(20, chunkWidth, true);
+  if (spawn) {
+    view.setFloat32(24, spawn.x, true);
+    view.setFloat32(28, spawn.y, true);
+  }
+  if (bounds) {
+    view.setFloat32(32, bounds.min.x, true);
+    view.setFloat32(36, bounds.min.y, true);
+    view.setFloat32(40, bounds.max.x, true);
+    view.setFloat32(44, bounds.max.y, true);
+  }
+  let offset = HEADER_BYTES;
+  for (const r of [...platforms, ...goals]) {
+    view.setFloat32(offset, r.position.x, true);
+    view.setFloat32(offset + 4, r.position.y, true);
+    view.setFloat32(offset + 8, r.size.x, true);
+    view.setFloat32(offset + 12, r.size.y, true);
+    offset += 16;
+  }
+  return bytes;
+};
+
+const validated = (level) => ({
+  spawn: isVec2(level.spawn) ? level.spawn : null,
+  bounds: level.bounds != null && isVec2(level.bounds.min) && isVec2(level.bounds.max) ? level.bounds : null,
+  platforms: (level.platforms ?? []).filter(isRecord),
+  goals: (level.goals ?? []).filter(isRecord),
+});
+
+// Returns the binary encoding of a parsed JSON level as a Uint8Array.
+export const encodeLevel = (level) => writeBinary({ ...validated(level), chunkWidth: 0 });
+
+// Chunk index of x, computed in float32 exactly as ChunkedWorld::chunkOf does.
+const f = Math.fround;
+const chunkOf = (x, width) => Math.min(Math.max(Math.floor(f(x / width)), -1073741824), 1073741824);
+
+// Splits a level for streaming. Returns the header-only level and a Map from chunk index
+// to chunk buffer.
+export const encodeChunkedLevel = (level, chunkWidth) => {
+  const { spawn, bounds, platforms, goals } = validated(level);
+  const width = f(chunkWidth);
+  const chunks = new Map();
+  const place = (record, key) => {
+    const halfX = f(f(record.size.x) / 2);
+    const first = chunkOf(f(f(record.position.x) - halfX), width);
+    const last = chunkOf(f(f(record.position.x) + halfX), width);
+    for (let k = first; k <= last; ++k) {
+      if (!chunks.has(k)) chunks.set(k, { platforms: [], goals: [] });
+      chunks.get(k)[key].push(record);
+    }
+  };
+  platforms.forEach((p) => place(p, 'platforms'));
+  goals.forEach((g) => place(g, 'goals'));
+
+  const encoded = new Map();
+  for (const [k, chunk] of chunks) {
+    encoded.set(k, writeBinary({ spawn: null, bounds: null, ...chunk, chunkWidth: width }));
+  }
+  return { header: writeBinary({ spawn, bounds, platforms: [], goals: [], chunkWidth: width }), chunks: encoded };
+};
+
+const convertFile = (path, chunkWidth) => {
+  const level = JSON.parse(readFileSync(path, 'utf8'));
+  const base = path.replace(/\.json$/, '');
+  if (chunkWidth > 0) {
+    const { header, chunks } = encodeChunkedLevel(level, chunkWidth);
+    writeFileSync(`${base}.bin`, header);
+    for (const [k, bytes] of chunks) writeFileSync(`${base}.chunk${k}.bin`, bytes);
+    console.log(`${path} -> ${base}.bin + ${chunks.size} chunks of width ${chunkWidth}`);
+  } else {
+    const bytes = encodeLevel(level);
+    writeFileSync(`${base}.bin`, bytes);
+    console.log(`${path} -> ${base}.bin (${bytes.length} bytes)`);
+  }
+};
+
+if (process.argv[1] === fileURLToPath(import.meta.url)) {
+  const args = process.argv.slice(2);
+  let chunkWidth = 0;
+  const flag = args.indexOf('--chunk-width');
+  if (flag >= 0) {
+    chunkWidth = Number(args[flag + 1]);
+    args.splice(flag, 2);
+  }
+  const targets = args.length > 0 ? args : ['public/levels'];
+  for (const target of targets) {
+    if (statSync(target).isDirectory()) {
+      for (const name of readdirSync(target)) {
+        if (name.endsWith('.json')) convertFile(join(target, name), chunkWidth);
+      }
+    } else {
+      convertFile(target, chunkWidth);
+    }
+  }
+}
@@ -1,12 +1,14 @@
 import React, { useRef, useEffect, useState } from 'react';
-import { Renderer } from '../gl/renderer';
-import { loadWasmModule, type Game, type InputState, type Platform, type Particle } from '../wasm/loader';
+import { Renderer, VIEW_WIDTH } from '../gl/renderer';
+import { loadWasmModule, loadLevelBinary, saveState, restoreState, streamChunks, forEachEvent, findStaticSpriteRanges, viewInstances, viewStaticSprites, viewFrameStats, getSoundNames, getAnimationNames, getInstanceLayout, type Game, type SpriteRange, type InputState, type Vec2 } from '../wasm/loader';
 import { AudioManager } from '../audio/AudioManager';
 
 import vertexShaderSource from '../gl/shaders/tex.vert.glsl?raw';
 import fragmentShaderSource from '../gl/shaders/tex.frag.glsl?raw';
 import backgroundFragmentSource from '../gl/shaders/background.frag.glsl?raw';
 import backgroundVertexSource from '../gl/shaders/background.vert.glsl?raw';
+import instancedVertexSource from '../gl/shaders/instanced.vert.glsl?raw';
+import instancedFragmentSource from '../gl/shaders/instanced.frag.glsl?raw';
 
 const WAZZY_SPRITESHEET_URL = './wazzy_spritesheet.png';
 const PLATFORM_TEXTURE_URL = './platform.png';
@@ -14,13 +16,25 @@ const BACKGROUND_URL = './background.png';
 const MUSIC_URL = './background-music.mp3';
 const JUMP_SFX_URL = './jump.mp3';
 const LAND_SFX_URL = './land.mp3';
+// Physics runs at a fixed rate regardless of display refresh; rendering interpolates between ticks.
+const PHYSICS_TICK_RATE = 60;
+const MAX_PHYSICS_SUBSTEPS = 5;
+// Only the -pthread build (build:wasm:threads, served cross-origin isolated) uses more than one;
+// keep this within its PTHREAD_POOL_SIZE.
+const MAX_SIMULATION_THREADS = 4;
+// Binary (and, for chunked levels, chunk) files are built from the JSON by `npm run build:levels`.
+const LEVEL_PATH = '/levels/test-1';
+// How far below the player's feet the debug line and sprite snapping look for ground.
+const GROUND_QUERY_DEPTH = 10;
+
+const lerpVec2 = (a: Vec2, b: Vec2, t: number): Vec2 => ({ x: a.x + (b.x - a.x) * t, y: a.y + (b.y - a.y) * t });
 
 
 
 const GameCanvas = () => {
   const canvasRef = useRef<HTMLCanvasElement>(null);
   const keysRef = useRef<Record<string, boolean>>({
-    'ArrowLeft': false, 'ArrowRight': false, 'Space': false,
+    'ArrowLeft': false, 'ArrowRight': false, 'Space': false, 'KeyR': false,
   });
   const audioManagerRef = useRef<AudioManager | null>(null);
   const [volume, setVolume] = useState(0.5);
@@ -56,10 +70,6 @@ const GameCanvas = () => {
     let gameInstance: Game | null = null;
     const audioManager = audioManagerRef.current!;
 
-    const handleSoundEvent = (soundName: string) => {
-      audioManager.playSfx(soundName);
-    };
-
     const initializeAndRun = async () => {
       try {
         await Promise.all([
@@ -70,34 +80,63 @@ const GameCanvas = () => {
 
         const wasmModule = await loadWasmModule();
         gameInstance = new wasmModule.Game();
-        gameInstance.setSoundCallback(handleSoundEvent);
-
-        // Register level complete callback: will be called from WASM when a goal is reached
-        (gameInstance as any).setLevelCompleteCallback(() => {
-          setLevelComplete(true);
-        });
+        gameInstance.setFixedTimestep(PHYSICS_TICK_RATE, MAX_PHYSICS_SUBSTEPS);
+        if (globalThis.crossOriginIsolated) {
+          gameInstance.setThreadCount(Math.min(MAX_SIMULATION_THREADS, navigator.hardwareConcurrency || 1));
+        }
+        // Sounds and goal completion arrive through the event queue drained after each update.
+        const soundNames = getSoundNames(wasmModule);
+        const handleGameEvent = (type: number, code: number) => {
+          if (type === wasmModule.EVENT_SOUND) {
+            const name = soundNames[code];
+            if (name) audioManager.playSfx(name);
+          } else if (type === wasmModule.EVENT_GOAL_REACHED) {
+            setLevelComplete(true);
+          }
+        };
 
-        // Load a predefined test level JSON from public/levels/test-1.json and pass it into the WASM game.
+        // Load the test level, preferring its binary build and falling back to the JSON itself.
         try {
-          const levelResp = await fetch('/levels/test-1.json');
-          if (levelResp.ok) {
-            const levelObj = await levelResp.json();
-            // Pass the raw JS object to embind; Game::loadLevel will parse it.
-            (gameInstance as any).loadLevel(levelObj);
-          } else {
-            console.warn('Failed to fetch level JSON:', levelResp.status);
+          const binaryResp = await fetch(`${LEVEL_PATH}.bin`);
+          const loaded = binaryResp.ok &&
+            loadLevelBinary(wasmModule, gameInstance, new Uint8Array(await binaryResp.arrayBuffer()));
+          if (!loaded) {
+            const levelResp = await fetch(`${LEVEL_PATH}.json`);
+            if (levelResp.ok) {
+              const levelObj = await levelResp.json();
+              // Pass the raw JS object to embind; Game::loadLevel will parse it.
+              gameInstance.loadLevel(levelObj);
+            } else {
+              console.warn('Failed to fetch level JSON:', levelResp.status);
+            }
           }
         } catch (err) {
-          console.warn('Error loading level JSON:', err);
+          console.warn('Error loading level:', err);
         }
 
-        const renderer = new Renderer(canvas, vertexShaderSource, fragmentShaderSource, backgroundVertexSource, backgroundFragmentSource);
+        // Instant retry (R): rewind to the state right after loading instead of reloading the level.
+        const startState = saveState(wasmModule, gameInstance);
+
+        const renderer = new Renderer(canvas, vertexShaderSource, fragmentShaderSource, backgroundVertexSource, backgroundFragmentSource, instancedVertexSource, instancedFragmentSource);
+        renderer.instanceLayout = getInstanceLayout(wasmModule);
+        renderer.setAnimationNames(getAnimationNames(wasmModule));
         const [playerTexture, platformTexture, backgroundTexture] = await Promise.all([
           renderer.loadTexture(WAZZY_SPRITESHEET_URL),
           renderer.loadTexture(PLATFORM_TEXTURE_URL),
           renderer.loadTexture(BACKGROUND_URL)
         ]);
         let lastTime = performance.now();
+        // Platforms only change with the geometry revision (level load, chunk streaming), so the
+        // static platform sprites are re-uploaded only then.
+        let platformRevision = -1;
+        const platformRanges: SpriteRange[] = []; // refilled every frame
+        // Profiler stats for the last update(), read in place; re-wrapped after memory growth.
+        // Only profiling builds (npm run build:wasm:profile) fill them in.
+        const profiling = gameInstance.getFrameStatsView().enabled;
+        let frameStats = viewFrameStats(wasmModule, gameInstance.getFrameStatsView());
+        // Chunk fetches in flight for chunked levels; whole levels never request any.
+        const chunkRequests = new Set<number>();
+        const chunkUrl = (chunk: number) => `${LEVEL_PATH}.chunk${chunk}.bin`;
 
         const gameLoop = (timestamp: number) => {
           if (!gameInstance) return;
@@ -108,38 +147,44 @@ const GameCanvas = () => {
             right: keysRef.current['ArrowRight'],
             jump: keysRef.current['Space'],
           };
+          if (keysRef.current['KeyR']) {
+            keysRef.current['KeyR'] = false; // once per press
+            if (restoreState(wasmModule, gameInstance, startState)) setLevelComplete(false);
+          }
+          streamChunks(wasmModule, gameInstance, chunkUrl, chunkRequests);
           gameInstance.handleInput(inputState);
           gameInstance.update(deltaTime);
-          const playerPosition = gameInstance.getPlayerPosition();
-          const cameraPosition = gameInstance.getCameraPosition();
-          const wasmPlatforms = gameInstance.getPlatforms();
+          forEachEvent(wasmModule, gameInstance.drainEvents(), handleGameEvent);
+          const alpha = gameInstance.getInterpolationAlpha();
+          const playerPosition = lerpVec2(gameInstance.getPreviousPlayerPosition(), gameInstance.getPlayerPosition(), alpha);
+          const cameraPosition = lerpVec2(gameInstance.getPreviousCameraPosition(), gameInstance.getCameraPosition(), alpha);
           const playerAnim = gameInstance.getPlayerAnimationState();
           const playerSize = gameInstance.getPlayerSize();
-          const jsPlatforms: Platform[] = [];
-          for (let i = 0; i < wasmPlatforms.size(); i++) {
-            jsPlatforms.push(wasmPlatforms.get(i));
+          if (platformRevision < 0 || gameInstance.hasGeometryChanged(platformRevision)) {
+            platformRevision = gameInstance.getPlatformRevision();
           }
-          const wasmParticles = gameInstance.getParticles();
-          const jsParticles: Particle[] = [];
-          for (let i = 0; i < wasmParticles.size(); i++) {
-            jsParticles.push(wasmParticles.get(i));
+          if (renderer.staticRevision !== platformRevision) {
+            renderer.setStaticSprites(viewStaticSprites(wasmModule, gameInstance.getStaticSpriteView()));
           }
+          // Sprites visible this frame, culled in C++; slightly oversized so nothing pops at the edges.
+          const viewHeight = VIEW_WIDTH * canvas.height / canvas.width;
+          const instances = viewInstances(wasmModule, gameInstance.buildRenderBuffer(VIEW_WIDTH + 1, viewHeight + 1));
+          const halfWidth = (VIEW_WIDTH + 1) / 2;
+          findStaticSpriteRanges(gameInstance, cameraPosition.x - halfWidth, cameraPosition.x + halfWidth, platformRanges);
 
-          // Debug: compute nearest platform top under the player horizontally
-          let nearestTop: number | null = null;
-          for (const p of jsPlatforms) {
-            const pxMin = p.position.x - p.size.x / 2;
-            const pxMax = p.position.x + p.size.x / 2;
-            if (playerPosition.x >= pxMin - 0.01 && playerPosition.x <= pxMax + 0.01) {
-              const top = p.position.y + p.size.y / 2;
-              if (nearestTop === null || top > nearestTop) nearestTop = top;
-            }
-          }
+          // Debug: top of the platform under the player's feet (a downward query in C++)
           const playerBottom = playerPosition.y - playerSize.y / 2;
+          const ground = gameInstance.findGroundBelow({ x: playerPosition.x, y: playerBottom }, GROUND_QUERY_DEPTH);
+          const nearestTop = ground.hit ? ground.point.y : null;
           const delta = nearestTop !== null ? (playerBottom - nearestTop) : null;
-          setDebugInfo(`playerY: ${playerPosition.y.toFixed(3)} bottom: ${playerBottom.toFixed(3)} platformTop: ${nearestTop !== null ? nearestTop.toFixed(3) : 'N/A'} delta: ${delta !== null ? delta.toFixed(3) : 'N/A'}`);
+          if (frameStats.summary.buffer !== wasmModule.HEAPF32.buffer) {
+            frameStats = viewFrameStats(wasmModule, gameInstance.getFrameStatsView());
+          }
+          const [, averageMicros, maxMicros] = frameStats.summary;
+          const timing = profiling ? ` update: ${averageMicros.toFixed(1)}us avg ${maxMicros.toFixed(1)}us max` : '';
+          setDebugInfo(`playerY: ${playerPosition.y.toFixed(3)} bottom: ${playerBottom.toFixed(3)} platformTop: ${nearestTop !== null ? nearestTop.toFixed(3) : 'N/A'} delta: ${delta !== null ? delta.toFixed(3) : 'N/A'}${timing}`);
 
-          renderer.drawScene(cameraPosition, playerPosition, playerSize, jsPlatforms, jsParticles, playerTexture, platformTexture, backgroundTexture, playerAnim);
+          renderer.drawScene(cameraPosition, playerPosition, playerSize, nearestTop, platformRanges, instances, playerTexture, platformTexture, backgroundTexture, playerAnim);
           animationFrameId = requestAnimationFrame(gameLoop);
         };
         animationFrameId = requestAnimationFrame(gameLoop);
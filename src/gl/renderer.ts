@@ -1,4 +1,7 @@
-import type { Vec2, Platform, AnimationState, Particle } from '../wasm/loader';
+import type { Vec2, AnimationState, RenderInstances, InstanceLayout, StaticSprites, SpriteRange } from '../wasm/loader';
+
+// Width of the visible world in world units; the height follows the canvas aspect ratio.
+export const VIEW_WIDTH = 10.0;
 
 export type TextureObject = {
   texture: WebGLTexture;
@@ -12,6 +15,8 @@ const animationMap = {
   jump: { row: 2, frames: 1, frameSize: { x: 64, y: 64 } },
 };
 
+type AnimationClip = typeof animationMap.idle;
+
 
 export class Renderer {
   private gl: WebGL2RenderingContext;
@@ -36,14 +41,32 @@ export class Renderer {
   private unitSquarePositionBuffer: WebGLBuffer | null = null;
   private unitSquareTexCoordBuffer: WebGLBuffer | null = null;
   private fullScreenQuadBuffer: WebGLBuffer | null = null;
+  private instancedProgram: WebGLProgram;
+  private instancedVertexArray: WebGLVertexArrayObject | null = null;
+  private instanceBuffer: WebGLBuffer | null = null;
+  private instanceBufferBytes = 0;
+  private staticBuffer: WebGLBuffer | null = null;
+  private staticStride = 8;
+  public staticRevision = -1;
+  private instancedAttributeLocations: Record<string, number> = {};
+  private instancedProjectionUniformLocation: WebGLUniformLocation | null;
+  private instancedCameraPositionUniformLocation: WebGLUniformLocation | null;
+  private instancedFrameUvSizeUniformLocation: WebGLUniformLocation | null;
+  private instancedAnchorUniformLocation: WebGLUniformLocation | null;
+  private instancedTextureUniformLocation: WebGLUniformLocation | null;
   // Map to store per-texture anchors: anchors.get(texture) -> array[row][frame] = offsetPx
   private anchors: Map<WebGLTexture, number[][]> = new Map();
   private debugRedTexture: TextureObject | null = null;
   private debugGreenTexture: TextureObject | null = null;
   private whiteTexture: TextureObject | null = null;
+  private entityTexture: TextureObject | null = null;
+  // Sprite-sheet clip per AnimationState.animation id (see setAnimationNames)
+  private animationsById: AnimationClip[] = [animationMap.idle, animationMap.run, animationMap.jump];
+  // Field offsets inside a sprite instance built by Game::buildRenderBuffer
+  public instanceLayout: InstanceLayout = { position: 0, size: 2, rotation: 4, alpha: 5, frame: 6 };
 
 
-  constructor(canvas: HTMLCanvasElement, spriteVsSource: string, spriteFsSource: string, bgVsSource: string, bgFsSource: string) {
+  constructor(canvas: HTMLCanvasElement, spriteVsSource: string, spriteFsSource: string, bgVsSource: string, bgFsSource: string, instancedVsSource: string, instancedFsSource: string) {
     const context = canvas.getContext('webgl2');
     if (!context) throw new Error('WebGL2 is not supported.');
     this.gl = context;
@@ -69,12 +92,24 @@ export class Renderer {
     this.backgroundTextureSizeUniformLocation = this.gl.getUniformLocation(this.backgroundProgram, 'u_texture_size');
     this.backgroundResolutionUniformLocation = this.gl.getUniformLocation(this.backgroundProgram, 'u_resolution');
     this.backgroundTextureUniformLocation = this.gl.getUniformLocation(this.backgroundProgram, 'u_texture');
+    const instancedVertexShader = this.compileShader(this.gl.VERTEX_SHADER, instancedVsSource);
+    const instancedFragmentShader = this.compileShader(this.gl.FRAGMENT_SHADER, instancedFsSource);
+    this.instancedProgram = this.createProgram(instancedVertexShader, instancedFragmentShader);
+    for (const name of ['a_position', 'a_texCoord', 'i_position', 'i_size', 'i_rotation', 'i_alpha', 'i_frame']) {
+      this.instancedAttributeLocations[name] = this.gl.getAttribLocation(this.instancedProgram, name);
+    }
+    this.instancedProjectionUniformLocation = this.gl.getUniformLocation(this.instancedProgram, 'u_projection');
+    this.instancedCameraPositionUniformLocation = this.gl.getUniformLocation(this.instancedProgram, 'u_camera_position');
+    this.instancedFrameUvSizeUniformLocation = this.gl.getUniformLocation(this.instancedProgram, 'u_frame_uv_size');
+    this.instancedAnchorUniformLocation = this.gl.getUniformLocation(this.instancedProgram, 'u_anchor');
+    this.instancedTextureUniformLocation = this.gl.getUniformLocation(this.instancedProgram, 'u_texture');
     this.gl.viewport(0, 0, canvas.width, canvas.height);
     this.setupGeometry();
     // create simple solid debug textures
     this.debugRedTexture = this.createSolidTexture([255, 0, 0, 128]);
     this.debugGreenTexture = this.createSolidTexture([0, 255, 0, 128]);
     this.whiteTexture = this.createSolidTexture([255, 255, 255, 255]);
+    this.entityTexture = this.createSolidTexture([255, 170, 0, 255]);
   }
 
   private compileShader(type: number, source: string): WebGLShader {
@@ -185,33 +220,112 @@ export class Renderer {
     this.fullScreenQuadBuffer = this.gl.createBuffer();
     this.gl.bindBuffer(this.gl.ARRAY_BUFFER, this.fullScreenQuadBuffer);
     this.gl.bufferData(this.gl.ARRAY_BUFFER, fullScreenPositions, this.gl.STATIC_DRAW);
+
+    // Instanced sprites: the unit quad per vertex, everything else per instance from instanceBuffer.
+    this.instanceBuffer = this.gl.createBuffer();
+    this.staticBuffer = this.gl.createBuffer();
+    this.instancedVertexArray = this.gl.createVertexArray();
+    this.gl.bindVertexArray(this.instancedVertexArray);
+    this.gl.enableVertexAttribArray(this.instancedAttributeLocations.a_position);
+    this.gl.bindBuffer(this.gl.ARRAY_BUFFER, this.unitSquarePositionBuffer);
+    this.gl.vertexAttribPointer(this.instancedAttributeLocations.a_position, 2, this.gl.FLOAT, false, 0, 0);
+    this.gl.enableVertexAttribArray(this.instancedAttributeLocations.a_texCoord);
+    this.gl.bindBuffer(this.gl.ARRAY_BUFFER, this.unitSquareTexCoordBuffer);
+    this.gl.vertexAttribPointer(this.instancedAttributeLocations.a_texCoord, 2, this.gl.FLOAT, false, 0, 0);
+    for (const name of ['i_position', 'i_size', 'i_rotation', 'i_alpha', 'i_frame']) {
+      this.gl.enableVertexAttribArray(this.instancedAttributeLocations[name]);
+      this.gl.vertexAttribDivisor(this.instancedAttributeLocations[name], 1);
+    }
+    this.gl.bindVertexArray(null);
   }
 
 
-  private drawSprite(position: Vec2, size: Vec2, textureObj: TextureObject, sheetSize: Vec2, frameSize: Vec2, frameCoord: Vec2, facingLeft: boolean, visualYOffset: number = 0) {
+  // Uploads the whole instance buffer with a single bufferSubData (reallocating the GL buffer
+  // only when it grows).
+  private uploadInstances(instances: RenderInstances) {
+    const { data, view } = instances;
+    const bytes = view.total * view.stride * 4;
+    this.gl.bindBuffer(this.gl.ARRAY_BUFFER, this.instanceBuffer);
+    if (bytes > this.instanceBufferBytes) {
+      this.instanceBufferBytes = Math.max(bytes, this.instanceBufferBytes * 2, 4096);
+      this.gl.bufferData(this.gl.ARRAY_BUFFER, this.instanceBufferBytes, this.gl.DYNAMIC_DRAW);
+    }
+    if (bytes > 0) this.gl.bufferSubData(this.gl.ARRAY_BUFFER, 0, data, 0, view.total * view.stride);
+  }
+
+
+  // Maps the game's animation ids (by name, from getAnimationNames) onto sprite-sheet clips.
+  public setAnimationNames(names: string[]) {
+    this.animationsById = names.map((name) => animationMap[name as keyof typeof animationMap] || animationMap.idle);
+  }
+
+
+  // Uploads the static platform sprites once per geometry revision; frames then only pick a range.
+  public setStaticSprites(sprites: StaticSprites) {
+    this.gl.bindBuffer(this.gl.ARRAY_BUFFER, this.staticBuffer);
+    this.gl.bufferData(this.gl.ARRAY_BUFFER, sprites.data, this.gl.STATIC_DRAW);
+    this.staticStride = sprites.view.stride;
+    this.staticRevision = sprites.view.revision;
+  }
+
+
+  // One instanced draw of instances [start, start + count) of an uploaded instance buffer.
+  private drawInstances(buffer: WebGLBuffer | null, stride: number, start: number, count: number, textureObj: TextureObject, frameUvSize: Vec2, anchor: number) {
+    if (count === 0) return;
+    const strideBytes = stride * 4;
+    const base = start * strideBytes;
+    const layout = this.instanceLayout;
+    const locations = this.instancedAttributeLocations;
+    this.gl.bindBuffer(this.gl.ARRAY_BUFFER, buffer);
+    this.gl.vertexAttribPointer(locations.i_position, 2, this.gl.FLOAT, false, strideBytes, base + layout.position * 4);
+    this.gl.vertexAttribPointer(locations.i_size, 2, this.gl.FLOAT, false, strideBytes, base + layout.size * 4);
+    this.gl.vertexAttribPointer(locations.i_rotation, 1, this.gl.FLOAT, false, strideBytes, base + layout.rotation * 4);
+    this.gl.vertexAttribPointer(locations.i_alpha, 1, this.gl.FLOAT, false, strideBytes, base + layout.alpha * 4);
+    this.gl.vertexAttribPointer(locations.i_frame, 2, this.gl.FLOAT, false, strideBytes, base + layout.frame * 4);
     this.gl.bindTexture(this.gl.TEXTURE_2D, textureObj.texture);
-    this.gl.uniform1i(this.spriteTextureUniformLocation, 0);
+    this.gl.uniform1i(this.instancedTextureUniformLocation, 0);
+    this.gl.uniform2f(this.instancedFrameUvSizeUniformLocation, frameUvSize.x, frameUvSize.y);
+    this.gl.uniform1f(this.instancedAnchorUniformLocation, anchor);
+    this.gl.drawArraysInstanced(this.gl.TRIANGLES, 0, 6, count);
+  }
+
 
-    // compute vertical anchor offset (in world units) if we have precomputed anchors for this texture
-    let modelPosY = position.y;
+  // Fraction of the sprite height to shift it down so its feet line up with the collision box bottom
+  private anchorFraction(textureObj: TextureObject, frameSize: Vec2, frameCoord: Vec2): number {
     const anchorsForTex = this.anchors.get(textureObj.texture);
     if (anchorsForTex) {
       // determine current frame indices
       const frameIndex = Math.round(frameCoord.x / (frameSize.x || 1));
       const rowIndex = Math.round(frameCoord.y / (frameSize.y || 1));
       if (anchorsForTex[rowIndex] && anchorsForTex[rowIndex][frameIndex] !== undefined) {
-        const offsetPx = anchorsForTex[rowIndex][frameIndex];
-        const offsetWorld = (offsetPx / frameSize.y) * size.y;
-        modelPosY = position.y - offsetWorld; // shift sprite down so foot aligns with collision bottom
-      }
-    } else {
-      // Fallback: if sprite frames are 64x64 (our player sheet), apply a small heuristic offset so feet sit lower
-      if (frameSize && frameSize.y === 64 && frameSize.x === 64) {
-        const fallbackFraction = 0.25; // increased: fraction of sprite height to lower the sprite
-        const offsetWorld = size.y * fallbackFraction;
-        modelPosY = position.y - offsetWorld;
+        return anchorsForTex[rowIndex][frameIndex] / frameSize.y;
       }
+      return 0;
     }
+    // Fallback: if sprite frames are 64x64 (our player sheet), apply a small heuristic offset so feet sit lower
+    if (frameSize && frameSize.y === 64 && frameSize.x === 64) {
+      return 0.25; // increased: fraction of sprite height to lower the sprite
+    }
+    return 0;
+  }
+
+
+  private bindQuadAttributes() {
+    this.gl.enableVertexAttribArray(this.spritePositionAttributeLocation);
+    this.gl.bindBuffer(this.gl.ARRAY_BUFFER, this.unitSquarePositionBuffer);
+    this.gl.vertexAttribPointer(this.spritePositionAttributeLocation, 2, this.gl.FLOAT, false, 0, 0);
+    this.gl.enableVertexAttribArray(this.spriteTexCoordAttributeLocation);
+    this.gl.bindBuffer(this.gl.ARRAY_BUFFER, this.unitSquareTexCoordBuffer);
+    this.gl.vertexAttribPointer(this.spriteTexCoordAttributeLocation, 2, this.gl.FLOAT, false, 0, 0);
+  }
+
+
+  private drawSprite(position: Vec2, size: Vec2, textureObj: TextureObject, sheetSize: Vec2, frameSize: Vec2, frameCoord: Vec2, facingLeft: boolean, visualYOffset: number = 0) {
+    this.gl.bindTexture(this.gl.TEXTURE_2D, textureObj.texture);
+    this.gl.uniform1i(this.spriteTextureUniformLocation, 0);
+
+    // shift sprite down so foot aligns with collision bottom
+    let modelPosY = position.y - this.anchorFraction(textureObj, frameSize, frameCoord) * size.y;
 
     // apply an additional visual Y offset (in world units), positive means move sprite down
     if (visualYOffset) modelPosY -= visualYOffset;
@@ -222,12 +336,7 @@ export class Renderer {
     this.gl.uniform2f(this.spriteFrameSizeUniformLocation, frameSize.x, frameSize.y);
     this.gl.uniform2f(this.spriteFrameCoordUniformLocation, frameCoord.x, frameCoord.y);
     this.gl.uniform1f(this.spriteFlipHorizontalUniformLocation, facingLeft ? 1.0 : 0.0);
-    this.gl.enableVertexAttribArray(this.spritePositionAttributeLocation);
-    this.gl.bindBuffer(this.gl.ARRAY_BUFFER, this.unitSquarePositionBuffer);
-    this.gl.vertexAttribPointer(this.spritePositionAttributeLocation, 2, this.gl.FLOAT, false, 0, 0);
-    this.gl.enableVertexAttribArray(this.spriteTexCoordAttributeLocation);
-    this.gl.bindBuffer(this.gl.ARRAY_BUFFER, this.unitSquareTexCoordBuffer);
-    this.gl.vertexAttribPointer(this.spriteTexCoordAttributeLocation, 2, this.gl.FLOAT, false, 0, 0);
+    this.bindQuadAttributes();
     this.gl.drawArrays(this.gl.TRIANGLES, 0, 6);
   }
 
@@ -259,51 +368,58 @@ export class Renderer {
     return { texture: tex, width: 1, height: 1 };
   }
 
-  public drawScene(cameraPosition: Vec2, playerPosition: Vec2, playerSize: Vec2, platforms: Platform[], particles: Particle[], playerTexture: TextureObject | null, platformTexture: TextureObject | null, backgroundTexture: TextureObject | null, playerAnim: AnimationState | null) {
+  // `instances` is the culled sprite buffer from Game::buildRenderBuffer and `platformRanges` the
+  // visible runs of the static sprites passed to setStaticSprites; `groundTop` (the platform top
+  // under the player, from Game::findGroundBelow) is only used to snap the player sprite onto it.
+  public drawScene(cameraPosition: Vec2, playerPosition: Vec2, playerSize: Vec2, groundTop: number | null, platformRanges: SpriteRange[], instances: RenderInstances, playerTexture: TextureObject | null, platformTexture: TextureObject | null, backgroundTexture: TextureObject | null, playerAnim: AnimationState | null) {
     this.gl.clearColor(0.1, 0.1, 0.1, 1.0);
     this.gl.clear(this.gl.COLOR_BUFFER_BIT);
     if (backgroundTexture) { this.drawBackground(cameraPosition, backgroundTexture); }
-    this.gl.useProgram(this.spriteProgram);
     const aspectRatio = this.gl.canvas.width / this.gl.canvas.height;
-    const worldWidth = 10.0;
+    const worldWidth = VIEW_WIDTH;
     const worldHeight = worldWidth / aspectRatio;
     const projectionMatrix = [2.0 / worldWidth, 0, 0, 0, 0, 2.0 / worldHeight, 0, 0, 0, 0, -1, 0, 0, 0, 0, 1];
-    this.gl.uniformMatrix4fv(this.spriteProjectionMatrixUniformLocation, false, projectionMatrix);
-    this.gl.uniform2f(this.spriteCameraPositionUniformLocation, cameraPosition.x, cameraPosition.y);
     this.gl.enable(this.gl.BLEND);
     this.gl.blendFunc(this.gl.SRC_ALPHA, this.gl.ONE_MINUS_SRC_ALPHA);
+
+    // Platforms (plus their debug collision boxes) come from the static buffer; entities and
+    // particles from one per-frame upload. One instanced draw per texture.
+    this.gl.useProgram(this.instancedProgram);
+    this.gl.uniformMatrix4fv(this.instancedProjectionUniformLocation, false, projectionMatrix);
+    this.gl.uniform2f(this.instancedCameraPositionUniformLocation, cameraPosition.x, cameraPosition.y);
+    this.gl.bindVertexArray(this.instancedVertexArray);
+    this.uploadInstances(instances);
+    const { view } = instances;
+    const whole = { x: 1, y: 1 };
     if (platformTexture) {
-      for (const platform of platforms) {
-        this.drawSprite(platform.position, platform.size, platformTexture, { x: platformTexture.width, y: platformTexture.height }, { x: platformTexture.width, y: platformTexture.height }, { x: 0, y: 0 }, false, 0);
+      const anchor = this.anchorFraction(platformTexture, { x: platformTexture.width, y: platformTexture.height }, { x: 0, y: 0 });
+      for (const run of platformRanges) {
+        this.drawInstances(this.staticBuffer, this.staticStride, run.start, run.count, platformTexture, whole, anchor);
       }
     }
-    // draw debug collision boxes (platforms = green, player = red)
     if (this.debugGreenTexture) {
-      for (const platform of platforms) {
-        // platform collision box: use platform.position and platform.size
-        this.drawSprite({ x: platform.position.x, y: platform.position.y }, { x: platform.size.x, y: platform.size.y }, this.debugGreenTexture, { x: 1, y: 1 }, { x: 1, y: 1 }, { x: 0, y: 0 }, false);
+      for (const run of platformRanges) {
+        this.drawInstances(this.staticBuffer, this.staticStride, run.start, run.count, this.debugGreenTexture, whole, 0);
       }
     }
-
-    // compute nearest platform top under the player horizontally (renderer-level)
-    let nearestTop: number | null = null;
-    for (const p of platforms) {
-      const pxMin = p.position.x - p.size.x / 2;
-      const pxMax = p.position.x + p.size.x / 2;
-      if (playerPosition.x >= pxMin - 0.01 && playerPosition.x <= pxMax + 0.01) {
-        const top = p.position.y + p.size.y / 2;
-        if (nearestTop === null || top > nearestTop) nearestTop = top;
-      }
+    if (this.entityTexture) {
+      this.drawInstances(this.instanceBuffer, view.stride, view.entityStart, view.entityCount, this.entityTexture, whole, 0);
     }
+    this.gl.bindVertexArray(null);
+
+    this.gl.useProgram(this.spriteProgram);
+    this.gl.uniformMatrix4fv(this.spriteProjectionMatrixUniformLocation, false, projectionMatrix);
+    this.gl.uniform2f(this.spriteCameraPositionUniformLocation, cameraPosition.x, cameraPosition.y);
+
     let visualYOffset = 0;
-    if (nearestTop !== null) {
+    if (groundTop !== null) {
       const playerBottom = playerPosition.y - playerSize.y / 2;
-      visualYOffset = playerBottom - nearestTop; // positive => sprite bottom is above platform top; move sprite down by this amount
+      visualYOffset = playerBottom - groundTop; // positive => sprite bottom is above platform top; move sprite down by this amount
       if (visualYOffset < 0 || visualYOffset > 0.2) visualYOffset = 0; // Only snap if close enough (avoid snapping when jumping high)
     }
 
     if (playerTexture && playerAnim) {
-      const animData = animationMap[playerAnim.currentState as keyof typeof animationMap] || animationMap.idle;
+      const animData = this.animationsById[playerAnim.animation] || animationMap.idle;
       const frame = playerAnim.currentFrame % animData.frames;
       const frameCoord = { x: frame * animData.frameSize.x, y: animData.row * animData.frameSize.y };
       // pass visualYOffset so sprite is nudged down to sit on platform
@@ -317,9 +433,10 @@ export class Renderer {
 
     // Draw particles
     if (this.whiteTexture) {
-      for (const p of particles) {
-        this.drawSprite(p.position, { x: p.size, y: p.size }, this.whiteTexture, { x: 1, y: 1 }, { x: 1, y: 1 }, { x: 0, y: 0 }, false, 0);
-      }
+      this.gl.useProgram(this.instancedProgram);
+      this.gl.bindVertexArray(this.instancedVertexArray);
+      this.drawInstances(this.instanceBuffer, view.stride, view.particleStart, view.particleCount, this.whiteTexture, { x: 1, y: 1 }, 0);
+      this.gl.bindVertexArray(null);
     }
   }
 
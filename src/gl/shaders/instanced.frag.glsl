@@ -0,0 +1,10 @@
+#version 300 es
+precision highp float;
+in vec2 v_texCoord;
+in float v_alpha;
+uniform sampler2D u_texture;
+out vec4 outColor;
+void main() {
+  vec4 color = texture(u_texture, v_texCoord);
+  outColor = vec4(color.rgb, color.a * v_alpha);
+}
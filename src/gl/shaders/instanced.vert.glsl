@@ -0,0 +1,25 @@
+#version 300 es
+in vec2 a_position;
+in vec2 a_texCoord;
+// Per instance, straight from the C++ SpriteInstance buffer
+in vec2 i_position;
+in vec2 i_size;
+in float i_rotation;
+in float i_alpha;
+in vec2 i_frame;
+uniform mat4 u_projection;
+uniform vec2 u_camera_position;
+uniform vec2 u_frame_uv_size; // one sprite-sheet cell in UV units; (1, 1) for whole-texture sprites
+uniform float u_anchor; // fraction of the sprite height to shift it down by
+out vec2 v_texCoord;
+out float v_alpha;
+void main() {
+  vec2 local = a_position * i_size;
+  float c = cos(i_rotation);
+  float s = sin(i_rotation);
+  vec2 world_position = vec2(c * local.x - s * local.y, s * local.x + c * local.y) + i_position;
+  world_position.y -= u_anchor * i_size.y;
+  gl_Position = u_projection * vec4(world_position - u_camera_position, 0.0, 1.0);
+  v_texCoord = (i_frame + a_texCoord) * u_frame_uv_size;
+  v_alpha = i_alpha;
+}
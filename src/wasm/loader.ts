@@ -6,43 +6,446 @@ export interface PlatformList { get(index: number): Platform; size(): number; }
 
 export interface InputState { left: boolean; right: boolean; jump: boolean; }
 
+// `animation` indexes getAnimationNames(module)
 export interface AnimationState {
-  currentState: string;
+  animation: number;
   currentFrame: number;
   facingLeft: boolean;
 }
 
-export interface Particle {
-  position: Vec2;
-  velocity: Vec2;
+// Location of a packed float array inside WASM memory (ptr is a byte address)
+export interface BufferView { ptr: number; count: number; stride: number; }
+
+// A Float32Array over WASM memory holding `count` records of `stride` floats each
+export interface RecordView { data: Float32Array; count: number; stride: number; }
+
+// Float offsets of the fields the renderer reads from platform records
+export interface RecordLayout {
+  platformPosition: number;
+  platformSize: number;
+}
+
+// The per-frame sprite instance buffer: `total` instances of `stride` floats at ptr, grouped
+// into one contiguous range per texture
+export interface RenderView {
+  ptr: number;
+  stride: number;
+  total: number;
+  entityStart: number;
+  entityCount: number;
+  particleStart: number;
+  particleCount: number;
+}
+
+// Float offsets of the fields inside one sprite instance
+export interface InstanceLayout {
+  position: number;
+  size: number;
+  rotation: number;
+  alpha: number;
+  frame: number;
+}
+
+export interface RenderInstances { data: Float32Array; view: RenderView; }
+
+// Platform sprites grouped by width class and sorted by left edge within each, rebuilt only
+// when the geometry revision changes
+export interface StaticSpriteView {
+  ptr: number;
+  stride: number;
+  count: number;
+  revision: number;
+}
+
+export interface SpriteRange { start: number; count: number; }
+
+// First platform hit by Game.raycast / Game.findGroundBelow. `normal` is (0, 0) when the query
+// started inside the platform.
+export interface RayHit { hit: boolean; platform: number; distance: number; point: Vec2; normal: Vec2; }
+
+export interface StaticSprites { data: Float32Array; view: StaticSpriteView; }
+
+// Heap location of the profiler's FrameStats for the last update() (packed 32-bit words)
+export interface FrameStatsView {
+  ptr: number;
+  phaseCount: number;
+  counterCount: number;
+  bucketCount: number;
+  enabled: boolean; // true only in profiling builds (npm run build:wasm:profile)
+}
+
+// Live typed-array views over FrameStats; they update in place after every update().
+// histogram[b] counts recent frames of [2^b, 2^(b+1)) microseconds (bucket 0: under 2).
+export interface FrameStats {
+  frames: Uint32Array;       // [frames completed]
+  summary: Float32Array;     // [frameMicros, averageMicros, maxMicros]
+  phaseMicros: Float32Array; // indexed like ProfileNames.phases
+  counters: Uint32Array;     // indexed like ProfileNames.counters
+  histogram: Uint32Array;
+}
+
+export interface ProfileNames { phases: string[]; counters: string[]; }
+
+// Heap byte addresses of the structure-of-arrays particle pool's fields
+export interface ParticleView {
+  count: number;
+  capacity: number;
+  positionX: number;
+  positionY: number;
   life: number;
   maxLife: number;
   size: number;
   rotation: number;
-  angularVelocity: number;
 }
 
-export interface ParticleList { get(index: number): Particle; size(): number; }
+// Float32Array views over the particle pool. They span the whole pool capacity;
+// only the first getParticleCount() entries are live.
+export interface ParticleArrays {
+  positionX: Float32Array;
+  positionY: Float32Array;
+  life: Float32Array;
+  maxLife: Float32Array;
+  size: Float32Array;
+  rotation: Float32Array;
+}
+
+// Pending events in the game's event ring: event i is slot (start + i) % capacity, and
+// each slot is four 32-bit words [type, code, x, y] starting at ptr
+export interface EventView {
+  ptr: number;
+  capacity: number;
+  start: number;
+  count: number;
+  dropped: number;
+}
+
+// Movement, ground probe, effect and animation tuning (cpp/src/PhysicsProfile.hpp).
+export interface PhysicsTuning {
+  gravity: number; // units/s^2, negative
+  moveSpeed: number;
+  jumpStrength: number; // take-off speed
+  enemySpeed: number;
+  groundCheckDistance: number;
+  jumpParticles: number;
+  landParticles: number;
+  runParticleChance: number; // percent of running steps
+  frameDuration: number; // seconds per animation frame
+}
+
+// Tuning profiles, as exposed by the embind enum (compare with module.PhysicsProfile.LowFx etc.)
+export interface PhysicsProfileValue { value: number; }
+
+export interface PhysicsProfiles {
+  Standard: PhysicsProfileValue;
+  LowFx: PhysicsProfileValue;
+  HighFx: PhysicsProfileValue;
+  Custom: PhysicsProfileValue; // getPhysicsTuning() values, read at run time
+}
+
+// Entity kinds, as exposed by the embind enum (compare with module.EntityKind.Enemy etc.)
+export interface EntityKindValue { value: number; }
+
+export interface EntityKinds {
+  Player: EntityKindValue;
+  Enemy: EntityKindValue;
+  Collectible: EntityKindValue;
+  MovingPlatform: EntityKindValue;
+}
+
+// Heap byte addresses of the entity component arrays. Entity 0 is the player; kind and
+// state are uint32 per entity, the rest float32.
+export interface EntityView {
+  count: number;
+  positionX: number;
+  positionY: number;
+  sizeX: number;
+  sizeY: number;
+  kind: number;
+  state: number;
+}
+
+// Typed-array views over the first `count` entities.
+export interface EntityArrays {
+  count: number;
+  positionX: Float32Array;
+  positionY: Float32Array;
+  sizeX: Float32Array;
+  sizeY: Float32Array;
+  kind: Uint32Array;
+  state: Uint32Array;
+}
 
 export interface Game {
   update(deltaTime: number): void;
   handleInput(inputState: InputState): void;
+  setFixedTimestep(tickRate: number, maxSubsteps: number): void;
+  setPhysicsProfile(profile: PhysicsProfileValue): void;
+  getPhysicsProfile(): PhysicsProfileValue;
+  setPhysicsTuning(tuning: PhysicsTuning): void; // switches to PhysicsProfile.Custom
+  getPhysicsTuning(): PhysicsTuning;
   getPlayerPosition(): Vec2;
   getPlayerSize(): Vec2;
   getCameraPosition(): Vec2;
+  getPreviousPlayerPosition(): Vec2;
+  getPreviousCameraPosition(): Vec2;
+  getInterpolationAlpha(): number;
   getPlatforms(): PlatformList;
-  getParticles(): ParticleList;
+  getPlatformView(): BufferView;
+  getParticleView(): ParticleView;
+  getParticleCount(): number;
+  getBurstCount(): number;
+  getBurstParticleCount(): number; // burst particles are only drawn via buildRenderBuffer
+  getPlatformRevision(): number;
+  hasGeometryChanged(sinceRevision: number): boolean;
+  getStaticSpriteView(): StaticSpriteView;
+  findStaticSpriteRanges(minX: number, maxX: number): number;
+  getStaticSpriteRange(index: number): SpriteRange;
+  buildRenderBuffer(viewWidth: number, viewHeight: number): RenderView;
+  raycast(origin: Vec2, direction: Vec2, maxDistance: number): RayHit; // distance in multiples of direction
+  findGroundBelow(point: Vec2, maxDistance: number): RayHit;
+  spawnEntity(kind: EntityKindValue, position: Vec2, size: Vec2): number;
+  spawnMovingPlatform(start: Vec2, end: Vec2, size: Vec2, speed: number): number; // runs start -> end and back
+  getEntityCount(): number;
+  getEntityView(): EntityView;
+  setThreadCount(threads: number): void; // no-op unless built with build:wasm:threads
+  getThreadCount(): number;
   getPlayerAnimationState(): AnimationState;
   setSoundCallback(callback: (soundName: string) => void): void;
   loadLevel(level: any): void; // accepts a plain JS object parsed from JSON
+  loadLevelBinary(ptr: number, length: number): boolean; // buffer already in WASM memory
+  loadGeneratedLevel(seed: number, platformCount: number, density: number): void; // density 0..1
+  setChunkRadius(radius: number): void;
+  getRequestedChunkCount(): number;
+  getRequestedChunk(index: number): number;
+  loadChunkBinary(chunk: number, ptr: number, length: number): boolean; // length 0 = empty chunk
+  setSeed(seed: number): void;
+  startRecording(seed: number, checksumInterval: number): void;
+  stopRecording(): void;
+  getRecordingData(): number;
+  getRecordingSize(): number;
+  startReplay(ptr: number, length: number): boolean;
+  runReplay(): number; // first diverging frame, or -1
+  isReplaying(): boolean;
+  getReplayDivergence(): number;
+  saveState(): number; // snapshot size in bytes, at getStateData() until the next saveState
+  getStateData(): number;
+  restoreState(ptr: number, length: number): boolean;
+  getStateChecksum(): number;
+  drainEvents(): EventView;
+  getFrameStatsView(): FrameStatsView;
+  getProfileJson(): string;
   setLevelCompleteCallback(callback: () => void): void;
   delete(): void;
+  isDeleted(): boolean;
 }
 
 export interface GameModule {
   Game: { new(): Game };
+  HEAPF32: Float32Array;
+  HEAPU8: Uint8Array;
+  HEAPU32: Uint32Array;
+  _malloc(size: number): number;
+  _free(ptr: number): void;
+  PLATFORM_POSITION: number;
+  PLATFORM_SIZE: number;
+  INSTANCE_POSITION: number;
+  INSTANCE_SIZE: number;
+  INSTANCE_ROTATION: number;
+  INSTANCE_ALPHA: number;
+  INSTANCE_FRAME: number;
+  EVENT_SOUND: number;
+  EVENT_GOAL_REACHED: number;
+  EVENT_STATE_CHANGED: number;
+  EVENT_COLLECTED: number;
+  EntityKind: EntityKinds;
+  PhysicsProfile: PhysicsProfiles;
+  SOUND_JUMP: number;
+  SOUND_LAND: number;
+  SOUND_COUNT: number;
+  soundName(sound: number): string;
+  ANIMATION_COUNT: number;
+  animationName(animation: number): string;
+  FRAME_STATS_PHASE_MICROS: number;
+  FRAME_STATS_COUNTERS: number;
+  FRAME_STATS_HISTOGRAM: number;
+  profilePhaseName(phase: number): string;
+  profileCounterName(counter: number): string;
 }
 
+// Wraps a BufferView as a zero-copy Float32Array. The result is only valid until WASM memory
+// grows (which replaces HEAPF32.buffer) or the C++ side reallocates the storage.
+export const viewRecords = (module: GameModule, view: BufferView): RecordView => {
+  const start = view.ptr >> 2;
+  return { data: module.HEAPF32.subarray(start, start + view.count * view.stride), count: view.count, stride: view.stride };
+};
+
+// Calls visit for every pending event, reading the ring in place. Must run before the next
+// handleInput/update, which may overwrite the slots.
+export const forEachEvent = (
+  module: GameModule,
+  view: EventView,
+  visit: (type: number, code: number, x: number, y: number) => void,
+): void => {
+  const words = view.ptr >> 2;
+  for (let i = 0; i < view.count; ++i) {
+    const slot = words + ((view.start + i) % view.capacity) * 4;
+    visit(module.HEAPU32[slot], module.HEAPU32[slot + 1], module.HEAPF32[slot + 2], module.HEAPF32[slot + 3]);
+  }
+};
+
+// Wraps the instance buffer from buildRenderBuffer. Valid until the next buildRenderBuffer call.
+export const viewInstances = (module: GameModule, view: RenderView): RenderInstances => {
+  const start = view.ptr >> 2;
+  return { data: module.HEAPF32.subarray(start, start + view.total * view.stride), view };
+};
+
+// Fills `ranges` with the runs of static sprites that may overlap [minX, maxX], at most one per
+// width class, so a level-spanning floor does not widen the run for the short platforms.
+export const findStaticSpriteRanges = (game: Game, minX: number, maxX: number, ranges: SpriteRange[]): SpriteRange[] => {
+  const count = game.findStaticSpriteRanges(minX, maxX);
+  ranges.length = count;
+  for (let i = 0; i < count; ++i) ranges[i] = game.getStaticSpriteRange(i);
+  return ranges;
+};
+
+// Wraps the static platform sprites. Copy or upload them right away: the layer is rebuilt on
+// the next geometry change.
+export const viewStaticSprites = (module: GameModule, view: StaticSpriteView): StaticSprites => {
+  const start = view.ptr >> 2;
+  return { data: module.HEAPF32.subarray(start, start + view.count * view.stride), view };
+};
+
+// The stats live inside the Game, so these views stay valid until WASM memory grows.
+export const viewFrameStats = (module: GameModule, view: FrameStatsView): FrameStats => {
+  const words = view.ptr >> 2;
+  const at = (offset: number) => words + offset;
+  return {
+    frames: module.HEAPU32.subarray(words, words + 1),
+    summary: module.HEAPF32.subarray(words + 1, words + 4),
+    phaseMicros: module.HEAPF32.subarray(at(module.FRAME_STATS_PHASE_MICROS), at(module.FRAME_STATS_PHASE_MICROS) + view.phaseCount),
+    counters: module.HEAPU32.subarray(at(module.FRAME_STATS_COUNTERS), at(module.FRAME_STATS_COUNTERS) + view.counterCount),
+    histogram: module.HEAPU32.subarray(at(module.FRAME_STATS_HISTOGRAM), at(module.FRAME_STATS_HISTOGRAM) + view.bucketCount),
+  };
+};
+
+// Sound and animation names by id; read once at startup so per-frame state stays numeric.
+export const getSoundNames = (module: GameModule): string[] =>
+  Array.from({ length: module.SOUND_COUNT }, (_, i) => module.soundName(i));
+
+export const getAnimationNames = (module: GameModule): string[] =>
+  Array.from({ length: module.ANIMATION_COUNT }, (_, i) => module.animationName(i));
+
+// Names for the phase and counter slots; read once at startup.
+export const getProfileNames = (module: GameModule, view: FrameStatsView): ProfileNames => ({
+  phases: Array.from({ length: view.phaseCount }, (_, i) => module.profilePhaseName(i)),
+  counters: Array.from({ length: view.counterCount }, (_, i) => module.profileCounterName(i)),
+});
+
+// The pool never reallocates, so these views stay valid until WASM memory grows.
+export const viewParticles = (module: GameModule, view: ParticleView): ParticleArrays => {
+  const field = (ptr: number) => module.HEAPF32.subarray(ptr >> 2, (ptr >> 2) + view.capacity);
+  return {
+    positionX: field(view.positionX),
+    positionY: field(view.positionY),
+    life: field(view.life),
+    maxLife: field(view.maxLife),
+    size: field(view.size),
+    rotation: field(view.rotation),
+  };
+};
+
+// The entity arrays move whenever entities are spawned or removed, so take a fresh view
+// every frame, after update().
+export const viewEntities = (module: GameModule, view: EntityView): EntityArrays => {
+  const floats = (ptr: number) => module.HEAPF32.subarray(ptr >> 2, (ptr >> 2) + view.count);
+  const words = (ptr: number) => module.HEAPU32.subarray(ptr >> 2, (ptr >> 2) + view.count);
+  return {
+    count: view.count,
+    positionX: floats(view.positionX),
+    positionY: floats(view.positionY),
+    sizeX: floats(view.sizeX),
+    sizeY: floats(view.sizeY),
+    kind: words(view.kind),
+    state: words(view.state),
+  };
+};
+
+// Copies bytes into a temporary WASM heap buffer for the duration of `use`.
+const withHeapCopy = (module: GameModule, bytes: Uint8Array, use: (ptr: number) => boolean): boolean => {
+  const ptr = module._malloc(bytes.length);
+  if (!ptr) return false;
+  try {
+    module.HEAPU8.set(bytes, ptr);
+    return use(ptr);
+  } finally {
+    module._free(ptr);
+  }
+};
+
+// Copies a binary level (see scripts/level-binary.mjs) into WASM memory and loads it in a
+// single call. Returns false if the game rejected the buffer.
+export const loadLevelBinary = (module: GameModule, game: Game, bytes: Uint8Array): boolean =>
+  withHeapCopy(module, bytes, (ptr) => game.loadLevelBinary(ptr, bytes.length));
+
+// Copies the finished recording (after stopRecording) out of WASM memory, e.g. to save it.
+export const copyRecording = (module: GameModule, game: Game): Uint8Array => {
+  const ptr = game.getRecordingData();
+  return module.HEAPU8.slice(ptr, ptr + game.getRecordingSize());
+};
+
+// Starts replaying a recording; the game keeps its own copy of the bytes.
+export const startReplay = (module: GameModule, game: Game, bytes: Uint8Array): boolean =>
+  withHeapCopy(module, bytes, (ptr) => game.startReplay(ptr, bytes.length));
+
+// Snapshots the whole simulation state (not the level geometry) into a JS-owned copy.
+export const saveState = (module: GameModule, game: Game): Uint8Array => {
+  const size = game.saveState();
+  const ptr = game.getStateData();
+  return module.HEAPU8.slice(ptr, ptr + size);
+};
+
+// Rewinds to a snapshot from saveState. Returns false, leaving the game as it was, if the
+// snapshot is malformed or was taken on another level. Chunk streaming in between is fine:
+// afterwards the game requests whatever chunks the restored camera needs.
+export const restoreState = (module: GameModule, game: Game, snapshot: Uint8Array): boolean =>
+  withHeapCopy(module, snapshot, (ptr) => game.restoreState(ptr, snapshot.length));
+
+// Fetches whatever chunks a chunked level is asking for; call once per frame. `pending`
+// carries the fetches in flight between calls. A chunk that is missing or unreadable is
+// handed over as empty so the game does not keep waiting on it.
+export const streamChunks = (module: GameModule, game: Game, chunkUrl: (chunk: number) => string, pending: Set<number>): void => {
+  const count = game.getRequestedChunkCount();
+  for (let i = 0; i < count; ++i) {
+    const chunk = game.getRequestedChunk(i);
+    if (pending.has(chunk)) continue;
+    pending.add(chunk);
+    fetch(chunkUrl(chunk))
+      .then((resp) => (resp.ok ? resp.arrayBuffer() : null))
+      .catch(() => null)
+      .then((buffer) => {
+        pending.delete(chunk);
+        if (game.isDeleted()) return;
+        const bytes = buffer ? new Uint8Array(buffer) : null;
+        if (!bytes || !withHeapCopy(module, bytes, (ptr) => game.loadChunkBinary(chunk, ptr, bytes.length))) {
+          game.loadChunkBinary(chunk, 0, 0);
+        }
+      });
+  }
+};
+
+export const getRecordLayout = (module: GameModule): RecordLayout => ({
+  platformPosition: module.PLATFORM_POSITION,
+  platformSize: module.PLATFORM_SIZE,
+});
+
+export const getInstanceLayout = (module: GameModule): InstanceLayout => ({
+  position: module.INSTANCE_POSITION,
+  size: module.INSTANCE_SIZE,
+  rotation: module.INSTANCE_ROTATION,
+  alpha: module.INSTANCE_ALPHA,
+  frame: module.INSTANCE_FRAME,
+});
+
 export const loadWasmModule = async (): Promise<GameModule> => {
   if ((window as any).createGameModule) {
     return await (window as any).createGameModule() as GameModule;
@@ -1,9 +1,18 @@
 import { defineConfig } from 'vite'
 import react from '@vitejs/plugin-react'
 
+const crossOriginIsolation = {
+  'Cross-Origin-Opener-Policy': 'same-origin',
+  'Cross-Origin-Embedder-Policy': 'require-corp',
+}
+
 // https://vitejs.dev/config/
 export default defineConfig({
   // Add this line:
   base: './', 
   plugins: [react()],
+  // Cross-origin isolation makes SharedArrayBuffer available to the -pthread wasm build
+  // (npm run build:wasm:threads); the single-threaded build doesn't need it.
+  server: { headers: crossOriginIsolation },
+  preview: { headers: crossOriginIsolation },
 })